@@ -0,0 +1,231 @@
+//// EnergyKernels.cpp
+#include "EnergyKernels.h"
+#include "SimdKernels.h"
+#include "opencv2/imgproc.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    // Minimum stripe height for the parallel engine; keeps the two halo rows
+    // converted per stripe a small fraction of the stripe's work.
+    constexpr int MIN_STRIPE_ROWS = 32;
+
+    // Long side of the spectral-residual proxy image (Hou & Zhang use 64)
+    constexpr int SALIENCY_PROXY_SIZE = 64;
+}
+
+/**
+ * @brief Streams rows [y0, y1) through a 3-row ring of padded gray rows (converted
+ * by grayFn) and applies rowFn (gray rows above/at/below -> energy row) to each.
+ */
+template <typename PadT, typename DstT, typename GrayFn, typename RowFn>
+static void streamEnergyRows(const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy, int y0, int y1, GrayFn grayFn, RowFn rowFn)
+{
+    const int rows = bgr.rows;
+    const int cols = bgr.cols;
+    const int stride = cols + 2;
+    const bool writeGray = !gray.empty();
+
+    // 3-row ring of padded gray rows; ringRow[k] holds image row ringY[k]
+    cv::AutoBuffer<PadT> ring(3 * stride);
+    PadT* ringRow[3] = { ring.data(), ring.data() + stride, ring.data() + 2 * stride };
+    int ringY[3] = { -1, -1, -1 };
+
+    // Returns the padded gray row for image row y, converting it on first use.
+    // The halo rows y0-1 and y1 are converted without writing the 8-bit gray,
+    // since they belong to a neighbouring stripe.
+    auto fetch = [&](int y) -> const PadT* {
+        y = reflectBorder(y, rows);
+        const int slot = y % 3;
+        if (ringY[slot] != y)
+        {
+            uchar* g8 = (writeGray && y >= y0 && y < y1) ? gray.ptr<uchar>(y) : nullptr;
+            PadT* gpad = ringRow[slot];
+            grayFn(bgr.ptr<uchar>(y), g8, gpad, cols);
+
+            // reflected padding (BORDER_REFLECT_101)
+            gpad[0] = gpad[1 + reflectBorder(-1, cols)];
+            gpad[cols + 1] = gpad[1 + reflectBorder(cols, cols)];
+            ringY[slot] = y;
+        }
+        return ringRow[slot];
+    };
+
+    for (int y = y0; y < y1; ++y)
+    {
+        const PadT* p0 = fetch(y - 1);
+        const PadT* p1 = fetch(y);
+        const PadT* p2 = fetch(y + 1);
+        rowFn(p0, p1, p2, energy.ptr<DstT>(y), cols);
+    }
+}
+
+/**
+ * @brief Fused single-pass energy kernel (BGR -> gray -> Sobel -> magnitude).
+ *
+ * Streams the image through a 3-row ring buffer of padded gray rows, so no
+ * full-size temporaries are created. Rows [y0, y1) of the output are written;
+ * rows y0-1 and y1 are read as halos (reflected at the image border).
+ * A CV_32F output receives the L2 magnitude; a CV_16U output the integer L1 magnitude.
+ * The row kernels come from the CPU-selected SimdKernels variant.
+ */
+void computeSobelEnergyRows(const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy, int y0, int y1)
+{
+    CV_Assert(bgr.type() == CV_8UC3 && energy.size() == bgr.size());
+    CV_Assert(energy.type() == CV_32F || energy.type() == CV_16U);
+
+    const SimdKernels& kernels = simdKernels();
+    if (energy.type() == CV_16U)
+        streamEnergyRows<short, ushort>(bgr, gray, energy, y0, y1, kernels.grayRowS16, kernels.sobelL1Row);
+    else
+        streamEnergyRows<float, float>(bgr, gray, energy, y0, y1, kernels.grayRowF32, kernels.sobelMagnitudeRow);
+}
+
+/**
+ * @brief SIMD colour-gradient kernel (ColourGradientEnergy) on interleaved CV_8UC3 rows.
+ *
+ * Uses deinterleaving loads to get the B, G and R planes of the 3x3 neighbourhood
+ * straight from the interleaved rows, computes the per-channel Sobel responses in
+ * int16 and reduces the squared responses of all channels in int32 registers
+ * (SimdKernels::colourGradientSpan); the border columns use the scalar functor.
+ */
+void computeColourGradientRows(const cv::Mat& bgr, cv::Mat& /*gray*/, cv::Mat& energy, int y0, int y1)
+{
+    CV_Assert(bgr.type() == CV_8UC3 && energy.type() == CV_32F && energy.size() == bgr.size());
+
+    const int rows = bgr.rows;
+    const int cols = bgr.cols;
+
+    for (int y = y0; y < y1; ++y)
+    {
+        const uchar* up = bgr.ptr<uchar>(reflectBorder(y - 1, rows));
+        const uchar* mid = bgr.ptr<uchar>(y);
+        const uchar* dn = bgr.ptr<uchar>(reflectBorder(y + 1, rows));
+        float* out = energy.ptr<float>(y);
+
+        if (cols < 3)
+        {
+            for (int x = 0; x < cols; ++x)
+                out[x] = ColourGradientEnergy::at(up, mid, dn, reflectBorder(x - 1, cols), x, reflectBorder(x + 1, cols));
+            continue;
+        }
+
+        out[0] = ColourGradientEnergy::at(up, mid, dn, 1, 0, 1);
+        int x = 1;
+        x = simdKernels().colourGradientSpan(up, mid, dn, out, x, cols);
+        for (; x < cols - 1; ++x)
+            out[x] = ColourGradientEnergy::at(up, mid, dn, x - 1, x, x + 1);
+        out[cols - 1] = ColourGradientEnergy::at(up, mid, dn, cols - 2, cols - 1, cols - 2);
+    }
+}
+
+/**
+ * @brief Local-variance energy for rows [y0, y1) from integral images.
+ * Interior pixels use the full window; only the window rows and columns are clipped
+ * at the border, so every pixel reads four entries of each integral.
+ */
+void computeLocalVarianceRows(const cv::Mat& sum, const cv::Mat& sqsum, cv::Mat& energy, int radius, int y0, int y1)
+{
+    const int cols = energy.cols;
+
+    for (int y = y0; y < y1; ++y)
+    {
+        float* out = energy.ptr<float>(y);
+        for (int x = 0; x < cols; ++x)
+            out[x] = localVarianceEnergyAt(sum, sqsum, y, x, radius);
+    }
+}
+
+/**
+ * @brief Spectral-residual saliency (Hou & Zhang 2007) of a BGR image.
+ * Runs on a proxy of at most 64 x 64 pixels, so its cost is independent of the
+ * image size apart from the two resizes.
+ */
+void computeSpectralResidualSaliency(const cv::Mat& bgr, cv::Mat& saliency, SaliencyBuffers& buf)
+{
+    // proxy size: long side fixed, short side rounded to a fast DFT length
+    const int longSide = std::max(bgr.cols, bgr.rows);
+    const int shortSide = std::min(bgr.cols, bgr.rows);
+    const int proxyShort = cv::getOptimalDFTSize(std::max(1, cvRound(static_cast<double>(SALIENCY_PROXY_SIZE) * shortSide / longSide)));
+    const cv::Size proxySize = (bgr.cols >= bgr.rows) ? cv::Size(SALIENCY_PROXY_SIZE, proxyShort)
+                                                      : cv::Size(proxyShort, SALIENCY_PROXY_SIZE);
+
+    cv::resize(bgr, buf.proxyBgr, proxySize, 0, 0, cv::INTER_AREA);
+    cv::cvtColor(buf.proxyBgr, buf.proxyGray, cv::COLOR_BGR2GRAY);
+    buf.proxyGray.convertTo(buf.proxy, CV_32F, 1.0 / 255.0);
+
+    cv::dft(buf.proxy, buf.spectrum, cv::DFT_COMPLEX_OUTPUT);
+
+    // split the spectrum into log amplitude and unit phase (kept in place)
+    buf.logAmplitude.create(proxySize, CV_32F);
+    for (int y = 0; y < proxySize.height; ++y)
+    {
+        cv::Vec2f* spec = buf.spectrum.ptr<cv::Vec2f>(y);
+        float* logAmp = buf.logAmplitude.ptr<float>(y);
+        for (int x = 0; x < proxySize.width; ++x)
+        {
+            const float amplitude = std::sqrt(spec[x][0] * spec[x][0] + spec[x][1] * spec[x][1]);
+            logAmp[x] = std::log(amplitude + 1e-6f);
+            if (amplitude > 0.f)
+                spec[x] *= 1.0f / amplitude;
+            else
+                spec[x] = cv::Vec2f(1.f, 0.f);
+        }
+    }
+
+    // spectral residual: log amplitude minus its local average, with the original phase
+    cv::blur(buf.logAmplitude, buf.meanLogAmplitude, cv::Size(3, 3));
+    for (int y = 0; y < proxySize.height; ++y)
+    {
+        cv::Vec2f* spec = buf.spectrum.ptr<cv::Vec2f>(y);
+        const float* logAmp = buf.logAmplitude.ptr<float>(y);
+        const float* meanLogAmp = buf.meanLogAmplitude.ptr<float>(y);
+        for (int x = 0; x < proxySize.width; ++x)
+            spec[x] *= std::exp(logAmp[x] - meanLogAmp[x]);
+    }
+
+    cv::dft(buf.spectrum, buf.spectrum, cv::DFT_INVERSE | cv::DFT_SCALE);
+
+    buf.response.create(proxySize, CV_32F);
+    for (int y = 0; y < proxySize.height; ++y)
+    {
+        const cv::Vec2f* spec = buf.spectrum.ptr<cv::Vec2f>(y);
+        float* out = buf.response.ptr<float>(y);
+        for (int x = 0; x < proxySize.width; ++x)
+            out[x] = spec[x][0] * spec[x][0] + spec[x][1] * spec[x][1];
+    }
+    cv::GaussianBlur(buf.response, buf.response, cv::Size(5, 5), 8.0);
+
+    double maxResponse = 0.0;
+    cv::minMaxLoc(buf.response, nullptr, &maxResponse);
+    buf.response.convertTo(buf.response, CV_32F, maxResponse > 0.0 ? 1.0 / maxResponse : 0.0);
+
+    cv::resize(buf.response, saliency, bgr.size(), 0, 0, cv::INTER_LINEAR);
+}
+
+/**
+ * @brief Multithreaded energy computation over horizontal stripes.
+ *
+ * The image is split into horizontal stripes that are each computed end-to-end
+ * by rowsFn on their own thread via cv::parallel_for_. Each stripe reads one halo
+ * row above and below, so stripes never share intermediates. The thread count
+ * follows cv::setNumThreads().
+ */
+void computeEnergyParallel(EnergyRowsFn rowsFn, const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy)
+{
+    const int rows = bgr.rows;
+
+    // a few stripes per thread so uneven stripes still balance out
+    const int threads = std::max(cv::getNumThreads(), 1);
+    const int stripes = std::max(1, std::min(threads * 4, rows / MIN_STRIPE_ROWS));
+
+    cv::parallel_for_(cv::Range(0, stripes), [&](const cv::Range& range) {
+        for (int s = range.start; s < range.end; ++s)
+        {
+            const int y0 = static_cast<int>(static_cast<int64>(rows) * s / stripes);
+            const int y1 = static_cast<int>(static_cast<int64>(rows) * (s + 1) / stripes);
+            rowsFn(bgr, gray, energy, y0, y1);
+        }
+    }, stripes);
+}
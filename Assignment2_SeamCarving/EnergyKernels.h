@@ -0,0 +1,471 @@
+#pragma once
+#include "opencv2/core.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+/**
+ * @file EnergyKernels.h
+ * @brief Low-level energy kernels shared by SeamCarver.
+ *
+ * All kernels produce the same Sobel gradient-magnitude energy as the OpenCV-call
+ * path in SeamCarver::computeEnergyMap(): 8-bit BGR is converted to luminance,
+ * a 3x3 Sobel is applied (reflected borders) and the L2 magnitude of the
+ * gradient, scaled to the [0, 1] gray range, is stored as CV_32F.
+ *
+ * In integer mode the same Sobel responses are kept in int16 and the L1
+ * magnitude |gx| + |gy| (range [0, 2040]) is stored as CV_16U instead.
+ *
+ * Other energies are provided as compile-time functors (SobelEnergy, ScharrEnergy,
+ * GradientL1Energy, DualGradientEnergy, ColourGradientEnergy) that are inlined
+ * into the generic row kernels computeEnergyRowsT / computeEnergySpanT.
+ *
+ * The local-variance energy works on windows instead of a 3x3 neighbourhood and
+ * reads the gray sums from integral images, so any window size costs O(1) per pixel.
+ * Spectral-residual saliency is computed once per job on a small proxy image and
+ * blended into whichever energy is selected.
+ */
+
+/**
+ * @brief Reflects an out-of-range index back into [0, len) (BORDER_REFLECT_101),
+ * matching the default border mode used by cv::Sobel.
+ */
+inline int reflectBorder(int p, int len)
+{
+    if (len == 1)
+        return 0;
+    if (p < 0)
+        return -p;
+    if (p >= len)
+        return 2 * len - 2 - p;
+    return p;
+}
+
+/**
+ * @brief Sobel L2 energy of a single pixel computed from three 8-bit gray rows.
+ *
+ * @param up  Gray row above (already border-reflected).
+ * @param mid Gray row containing the pixel.
+ * @param dn  Gray row below (already border-reflected).
+ * @param xl  Column of the left neighbour (already border-reflected).
+ * @param x   Column of the pixel.
+ * @param xr  Column of the right neighbour (already border-reflected).
+ * @return Gradient magnitude of the pixel.
+ */
+inline float sobelEnergyAt(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+{
+    constexpr float scale = 1.0f / 255.0f;
+
+    // 3x3 Sobel on the 8-bit values, scaled afterwards like the CV_32F path
+    const int gx = (up[xr] - up[xl]) + 2 * (mid[xr] - mid[xl]) + (dn[xr] - dn[xl]);
+    const int gy = (dn[xl] - up[xl]) + 2 * (dn[x] - up[x]) + (dn[xr] - up[xr]);
+
+    const float fx = gx * scale;
+    const float fy = gy * scale;
+    return std::sqrt(fx * fx + fy * fy);
+}
+
+/**
+ * @brief Integer Sobel L1 energy of a single pixel computed from three 8-bit gray rows.
+ * Parameters are the same as sobelEnergyAt().
+ * @return |gx| + |gy| of the unscaled 8-bit Sobel responses.
+ */
+inline ushort sobelL1EnergyAt(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+{
+    const int gx = (up[xr] - up[xl]) + 2 * (mid[xr] - mid[xl]) + (dn[xr] - dn[xl]);
+    const int gy = (dn[xl] - up[xl]) + 2 * (dn[x] - up[x]) + (dn[xr] - up[xr]);
+    return static_cast<ushort>(std::abs(gx) + std::abs(gy));
+}
+
+/**
+ * @brief Luminance of one BGR pixel, with the Q14 fixed-point coefficients of cv::cvtColor.
+ */
+inline uchar grayAt(const uchar* bgr)
+{
+    return static_cast<uchar>((bgr[0] * 1868 + bgr[1] * 9617 + bgr[2] * 4899 + (1 << 13)) >> 14);
+}
+
+/**
+ * @brief Local-variance energy of a single pixel from integral images of gray and gray^2.
+ * The (2 * radius + 1)^2 window is clipped at the image border; the energy is the
+ * standard deviation of the window, scaled to the [0, 1] gray range.
+ *
+ * @param sum    CV_64F integral of the 8-bit gray image ((rows + 1) x (cols + 1)).
+ * @param sqsum  CV_64F integral of the squared gray values (same size as sum).
+ * @param y      Row of the pixel.
+ * @param x      Column of the pixel.
+ * @param radius Window radius.
+ * @return Standard deviation of the window.
+ */
+inline float localVarianceEnergyAt(const cv::Mat& sum, const cv::Mat& sqsum, int y, int x, int radius)
+{
+    const int rows = sum.rows - 1;
+    const int cols = sum.cols - 1;
+
+    const int y0 = std::max(y - radius, 0);
+    const int y1 = std::min(y + radius + 1, rows);
+    const int x0 = std::max(x - radius, 0);
+    const int x1 = std::min(x + radius + 1, cols);
+    const double n = static_cast<double>((y1 - y0) * (x1 - x0));
+
+    const double* s0 = sum.ptr<double>(y0);
+    const double* s1 = sum.ptr<double>(y1);
+    const double* q0 = sqsum.ptr<double>(y0);
+    const double* q1 = sqsum.ptr<double>(y1);
+
+    const double s = s1[x1] - s1[x0] - s0[x1] + s0[x0];
+    const double q = q1[x1] - q1[x0] - q0[x1] + q0[x0];
+    const double var = std::max((q - s * s / n) / n, 0.0);
+
+    return static_cast<float>(std::sqrt(var) * (1.0 / 255.0));
+}
+
+/**
+ * @brief Row kernel signature shared by all full-map energy kernels.
+ * Computes rows [y0, y1) of energy from bgr (and/or the 8-bit gray image).
+ */
+typedef void (*EnergyRowsFn)(const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy, int y0, int y1);
+
+/**
+ * @brief Band kernel signature used by incremental updates.
+ * Recomputes energy row y for columns [x0, x1] from bgr and/or gray.
+ */
+typedef void (*EnergySpanFn)(const cv::Mat& bgr, const cv::Mat& gray, cv::Mat& energy, int y, int x0, int x1);
+
+/**
+ * @brief Probe kernel signature used by the lazy greedy seam search.
+ * Computes the energy of n pixels straight from bgr, without gray image or energy map.
+ */
+typedef void (*EnergyProbeFn)(const cv::Mat& bgr, const cv::Point* pixels, int n, float* energy);
+
+//////////////////////////////// Energy functors ////////////////////////////////
+//
+// Each functor computes the energy of one pixel from its 3x3 neighbourhood:
+//   static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr);
+// where up/mid/dn are the rows above/at/below the pixel and xl/x/xr the (already
+// border-reflected) columns. Gray functors read 8-bit gray rows, colour functors
+// (colour == true) read interleaved 8-bit BGR rows. All supports are 3x3, so the
+// incremental band update (seam +-2 px) stays valid for every functor.
+
+/**
+ * @brief Sobel L2 gradient magnitude on gray (the default energy).
+ */
+struct SobelEnergy {
+    static constexpr bool colour = false;
+    static constexpr const char* name = "sobel";
+    static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+    {
+        return sobelEnergyAt(up, mid, dn, xl, x, xr);
+    }
+};
+
+/**
+ * @brief Scharr L2 gradient magnitude on gray (more rotation-invariant than Sobel).
+ */
+struct ScharrEnergy {
+    static constexpr bool colour = false;
+    static constexpr const char* name = "scharr";
+    static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+    {
+        constexpr float scale = 1.0f / 255.0f;
+        const int gx = 3 * (up[xr] - up[xl]) + 10 * (mid[xr] - mid[xl]) + 3 * (dn[xr] - dn[xl]);
+        const int gy = 3 * (dn[xl] - up[xl]) + 10 * (dn[x] - up[x]) + 3 * (dn[xr] - up[xr]);
+        const float fx = gx * scale;
+        const float fy = gy * scale;
+        return std::sqrt(fx * fx + fy * fy);
+    }
+};
+
+/**
+ * @brief Sobel L1 gradient |gx| + |gy| on gray, as float (no sqrt).
+ */
+struct GradientL1Energy {
+    static constexpr bool colour = false;
+    static constexpr const char* name = "l1";
+    static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+    {
+        constexpr float scale = 1.0f / 255.0f;
+        return sobelL1EnergyAt(up, mid, dn, xl, x, xr) * scale;
+    }
+};
+
+/**
+ * @brief Integer Sobel L1 gradient |gx| + |gy| on gray, in the unscaled units of the
+ * CV_16U map. Only used to evaluate single pixels; full maps use the integer engines.
+ */
+struct IntegerSobelEnergy {
+    static constexpr bool colour = false;
+    static constexpr const char* name = "sobel-u16";
+    static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+    {
+        return sobelL1EnergyAt(up, mid, dn, xl, x, xr);
+    }
+};
+
+/**
+ * @brief Dual-gradient energy on BGR: sqrt of the summed squared central
+ * differences of all channels in x and y.
+ */
+struct DualGradientEnergy {
+    static constexpr bool colour = true;
+    static constexpr const char* name = "dual";
+    static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+    {
+        constexpr float scale = 1.0f / 255.0f;
+        int sum = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+            const int dx = mid[3 * xr + c] - mid[3 * xl + c];
+            const int dy = dn[3 * x + c] - up[3 * x + c];
+            sum += dx * dx + dy * dy;
+        }
+        return std::sqrt(static_cast<float>(sum)) * scale;
+    }
+};
+
+/**
+ * @brief Colour-gradient energy on BGR: per-channel 3x3 Sobel, combined as the
+ * L2 norm over all channels and both directions, so chroma edges count too.
+ */
+struct ColourGradientEnergy {
+    static constexpr bool colour = true;
+    static constexpr const char* name = "colour";
+    static float at(const uchar* up, const uchar* mid, const uchar* dn, int xl, int x, int xr)
+    {
+        constexpr float scale = 1.0f / 255.0f;
+        int sum = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+            const int l = 3 * xl + c, m = 3 * x + c, r = 3 * xr + c;
+            const int gx = (up[r] - up[l]) + 2 * (mid[r] - mid[l]) + (dn[r] - dn[l]);
+            const int gy = (dn[l] - up[l]) + 2 * (dn[m] - up[m]) + (dn[r] - up[r]);
+            sum += gx * gx + gy * gy;
+        }
+        return std::sqrt(static_cast<float>(sum)) * scale;
+    }
+};
+
+/**
+ * @brief Generic full-map kernel for an energy functor: rows [y0, y1) of a CV_32F map.
+ * Interior columns use fixed neighbours so the functor inlines into a branch-free loop.
+ * Matches the EnergyRowsFn signature; gray must already hold the current luminance.
+ */
+template <class Energy>
+void computeEnergyRowsT(const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy, int y0, int y1)
+{
+    const cv::Mat& src = Energy::colour ? bgr : gray;
+    const int rows = src.rows;
+    const int cols = src.cols;
+
+    for (int y = y0; y < y1; ++y)
+    {
+        const uchar* up = src.ptr<uchar>(reflectBorder(y - 1, rows));
+        const uchar* mid = src.ptr<uchar>(y);
+        const uchar* dn = src.ptr<uchar>(reflectBorder(y + 1, rows));
+        float* out = energy.ptr<float>(y);
+
+        if (cols == 1)
+        {
+            out[0] = Energy::at(up, mid, dn, 0, 0, 0);
+            continue;
+        }
+
+        out[0] = Energy::at(up, mid, dn, 1, 0, 1);
+        for (int x = 1; x < cols - 1; ++x)
+            out[x] = Energy::at(up, mid, dn, x - 1, x, x + 1);
+        out[cols - 1] = Energy::at(up, mid, dn, cols - 2, cols - 1, cols - 2);
+    }
+}
+
+/**
+ * @brief Generic band kernel for an energy functor (EnergySpanFn signature):
+ * recomputes row y, columns [x0, x1] of a CV_32F map.
+ */
+template <class Energy>
+void computeEnergySpanT(const cv::Mat& bgr, const cv::Mat& gray, cv::Mat& energy, int y, int x0, int x1)
+{
+    const cv::Mat& src = Energy::colour ? bgr : gray;
+    const int rows = src.rows;
+    const int cols = src.cols;
+
+    const uchar* up = src.ptr<uchar>(reflectBorder(y - 1, rows));
+    const uchar* mid = src.ptr<uchar>(y);
+    const uchar* dn = src.ptr<uchar>(reflectBorder(y + 1, rows));
+    float* out = energy.ptr<float>(y);
+
+    for (int x = x0; x <= x1; ++x)
+        out[x] = Energy::at(up, mid, dn, reflectBorder(x - 1, cols), x, reflectBorder(x + 1, cols));
+}
+
+/**
+ * @brief Generic probe kernel for an energy functor (EnergyProbeFn signature).
+ * Gray functors get a 3x3 gray patch converted from the pixel's BGR neighbourhood,
+ * colour functors read the BGR rows directly, so each pixel costs O(1) whatever
+ * the image size. Matches the map kernels, which use the same gray values.
+ */
+template <class Energy>
+void probeEnergyT(const cv::Mat& bgr, const cv::Point* pixels, int n, float* energy)
+{
+    const int rows = bgr.rows;
+    const int cols = bgr.cols;
+
+    for (int i = 0; i < n; ++i)
+    {
+        const int x = pixels[i].x;
+        const int y = pixels[i].y;
+        const int xs[3] = { reflectBorder(x - 1, cols), x, reflectBorder(x + 1, cols) };
+        const uchar* src[3] = { bgr.ptr<uchar>(reflectBorder(y - 1, rows)), bgr.ptr<uchar>(y),
+                                bgr.ptr<uchar>(reflectBorder(y + 1, rows)) };
+
+        if (Energy::colour)
+        {
+            energy[i] = Energy::at(src[0], src[1], src[2], xs[0], xs[1], xs[2]);
+            continue;
+        }
+
+        // patch[r][k] is the gray value of row y - 1 + r, column xs[k]
+        uchar patch[3][3];
+        for (int r = 0; r < 3; ++r)
+            for (int k = 0; k < 3; ++k)
+                patch[r][k] = grayAt(src[r] + 3 * xs[k]);
+        energy[i] = Energy::at(patch[0], patch[1], patch[2], 0, 1, 2);
+    }
+}
+
+/**
+ * @brief Kernels selected for one energy functor. SeamCarver stores one of these so
+ * the functor is dispatched once per map/band, never per pixel.
+ */
+struct EnergyKernelSet {
+    EnergyRowsFn rows;  // Full-map row kernel.
+    EnergySpanFn span;  // Incremental band kernel.
+    EnergyProbeFn probe; // Per-pixel kernel of the lazy greedy search.
+    bool builtin;       // True for the default Sobel energy, which has specialised engines.
+    const char* name;   // Short name used in reports.
+};
+
+/**
+ * @brief Builds the kernel set for an energy functor.
+ */
+template <class Energy>
+EnergyKernelSet energyKernelsFor()
+{
+    EnergyKernelSet set;
+    set.rows = &computeEnergyRowsT<Energy>;
+    set.span = &computeEnergySpanT<Energy>;
+    set.probe = &probeEnergyT<Energy>;
+    set.builtin = false;
+    set.name = Energy::name;
+    return set;
+}
+
+/**
+ * @brief The default Sobel energy keeps its specialised OpenCV / fused / parallel /
+ * integer engines; the generic kernels are only used as a reference.
+ */
+template <>
+inline EnergyKernelSet energyKernelsFor<SobelEnergy>()
+{
+    EnergyKernelSet set;
+    set.rows = &computeEnergyRowsT<SobelEnergy>;
+    set.span = &computeEnergySpanT<SobelEnergy>;
+    set.probe = &probeEnergyT<SobelEnergy>;
+    set.builtin = true;
+    set.name = SobelEnergy::name;
+    return set;
+}
+
+/**
+ * @brief SIMD colour-gradient kernel (ColourGradientEnergy) on interleaved CV_8UC3 rows.
+ *
+ * Uses deinterleaving loads to get the B, G and R planes of the 3x3 neighbourhood
+ * straight from the interleaved rows, computes the per-channel Sobel responses in
+ * int16 and reduces the squared responses of all channels in int32 registers, so no
+ * cv::split or per-channel maps are needed. Matches ColourGradientEnergy::at() exactly.
+ * Matches the EnergyRowsFn signature; gray is not used.
+ */
+void computeColourGradientRows(const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy, int y0, int y1);
+
+/**
+ * @brief The colour-gradient energy uses its SIMD deinterleaving row kernel.
+ */
+template <>
+inline EnergyKernelSet energyKernelsFor<ColourGradientEnergy>()
+{
+    EnergyKernelSet set;
+    set.rows = &computeColourGradientRows;
+    set.span = &computeEnergySpanT<ColourGradientEnergy>;
+    set.probe = &probeEnergyT<ColourGradientEnergy>;
+    set.builtin = false;
+    set.name = ColourGradientEnergy::name;
+    return set;
+}
+
+/**
+ * @brief Fused single-pass energy kernel (BGR -> gray -> Sobel -> magnitude).
+ *
+ * Streams the image through a 3-row ring buffer of padded gray rows, so no
+ * full-size temporaries are created. Rows [y0, y1) of the output are written;
+ * rows y0-1 and y1 are read as halos (reflected at the image border).
+ *
+ * @param bgr    Input CV_8UC3 image.
+ * @param gray   Output CV_8U luminance (same size as bgr), or an empty Mat to skip it.
+ * @param energy Output energy map (same size as bgr): CV_32F for the L2 magnitude,
+ *               CV_16U for the integer L1 magnitude.
+ * @param y0     First row to compute.
+ * @param y1     One past the last row to compute.
+ */
+void computeSobelEnergyRows(const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy, int y0, int y1);
+
+/**
+ * @brief Local-variance energy for rows [y0, y1) from integral images.
+ * See localVarianceEnergyAt(); the integrals must describe the image the energy map
+ * belongs to, so energy has sum.rows - 1 rows and sum.cols - 1 columns (CV_32F).
+ */
+void computeLocalVarianceRows(const cv::Mat& sum, const cv::Mat& sqsum, cv::Mat& energy, int radius, int y0, int y1);
+
+/**
+ * @brief Work buffers of computeSpectralResidualSaliency().
+ * Owned by the caller (one per SeamCarver) and kept between jobs: cv::Mat::create()
+ * is a no-op when the proxy size repeats, so cv::dft and the filters run without
+ * reallocating.
+ */
+struct SaliencyBuffers {
+    cv::Mat proxyBgr;     // CV_8UC3 proxy image
+    cv::Mat proxyGray;    // CV_8U proxy luminance
+    cv::Mat proxy;        // CV_32F proxy luminance in [0, 1]
+    cv::Mat spectrum;     // CV_32FC2 spectrum, reused for the inverse transform
+    cv::Mat logAmplitude; // CV_32F log amplitude
+    cv::Mat meanLogAmplitude; // CV_32F 3x3 local mean of the log amplitude
+    cv::Mat response;     // CV_32F squared inverse transform
+};
+
+/**
+ * @brief Spectral-residual saliency (Hou & Zhang 2007) of a BGR image.
+ *
+ * The image is reduced to a proxy whose long side is 64 pixels (short side rounded
+ * to a fast DFT size). The log-amplitude spectrum minus its 3x3 local mean is
+ * combined with the original phase and transformed back; the squared response is
+ * smoothed, normalised to [0, 1] and upsampled to the image size. The DFT buffers
+ * live in buffers and are reused whenever the proxy size repeats.
+ *
+ * @param bgr      Input CV_8UC3 image.
+ * @param saliency Output CV_32F saliency map (same size as bgr).
+ * @param buffers  Work buffers of the caller.
+ */
+void computeSpectralResidualSaliency(const cv::Mat& bgr, cv::Mat& saliency, SaliencyBuffers& buffers);
+
+/**
+ * @brief Multithreaded energy computation over horizontal stripes.
+ *
+ * The image is split into horizontal stripes that are each computed end-to-end
+ * by rowsFn (e.g. computeSobelEnergyRows: gray, Sobel, magnitude) on their own
+ * thread via cv::parallel_for_. Each stripe reads one halo row above and below,
+ * so stripes never share intermediates. The thread count follows cv::setNumThreads().
+ *
+ * @param rowsFn Row kernel run on each stripe.
+ * @param bgr    Input CV_8UC3 image.
+ * @param gray   CV_8U luminance passed to rowsFn (output for the fused Sobel kernel).
+ * @param energy Output energy map (same size as bgr).
+ */
+void computeEnergyParallel(EnergyRowsFn rowsFn, const cv::Mat& bgr, cv::Mat& gray, cv::Mat& energy);
@@ -0,0 +1,17 @@
+#pragma once
+#include "opencv2/core/hal/interface.h"
+
+/**
+ * @file MaskLabel.h
+ * @brief Labels of the SeamCarver mask layer, kept apart from SeamCarver.h so the
+ * SIMD kernel variants can use them without pulling in all of OpenCV.
+ */
+
+/**
+ * @brief Per-pixel labels of the optional SeamCarver mask layer.
+ */
+enum class MaskLabel : uchar {
+    None = 0,    // No bias.
+    Protect = 1, // Seams avoid these pixels.
+    Remove = 2   // Seams are drawn through these pixels (object removal).
+};
@@ -1,24 +1,32 @@
 //// SeamCarver.cpp
 #include "SeamCarver.h"
 #include <opencv2/imgproc.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <iomanip>
+#include <type_traits>
 
 #ifdef SOLUTION
 
 // Anonymous namespace to store timing variables
 namespace {
     double total_energy_time = 0.0;
+    double total_energy_update_time = 0.0;
     double total_vertical_seam_time = 0.0;
     double total_horizontal_seam_time = 0.0;
     double total_vertical_remove_time = 0.0;
     double total_horizontal_remove_time = 0.0;
+    double total_transpose_time = 0.0;
     int energy_calls = 0;
+    int energy_update_calls = 0;
     int vertical_seam_calls = 0;
     int horizontal_seam_calls = 0;
     int vertical_remove_calls = 0;
     int horizontal_remove_calls = 0;
+    int transpose_calls = 0;
 }
 
 /**
@@ -26,11 +34,17 @@ namespace {
  */
 void printTimingResults() {
     std::cout << "\n===TimeTest===" << std::endl;
+    std::cout << "Kernel variant: " << simdKernels().name << " (" << simdKernels().floatLanes << " float lanes)" << std::endl;
     std::cout << "Energy Calculation:" << std::endl;
     std::cout << "  Calls: " << energy_calls << std::endl;
     std::cout << "  Total time: " << std::fixed << std::setprecision(4) << total_energy_time << "s" << std::endl;
     std::cout << "  Average time: " << (energy_calls > 0 ? total_energy_time / energy_calls : 0) << "s" << std::endl;
 
+    std::cout << "\nIncremental Energy Update:" << std::endl;
+    std::cout << "  Calls: " << energy_update_calls << std::endl;
+    std::cout << "  Total time: " << total_energy_update_time << "s" << std::endl;
+    std::cout << "  Average time: " << (energy_update_calls > 0 ? total_energy_update_time / energy_update_calls : 0) << "s" << std::endl;
+
     std::cout << "\nVertical Seam Finding:" << std::endl;
     std::cout << "  Calls: " << vertical_seam_calls << std::endl;
     std::cout << "  Total time: " << total_vertical_seam_time << "s" << std::endl;
@@ -51,11 +65,19 @@ void printTimingResults() {
     std::cout << "  Total time: " << total_horizontal_remove_time << "s" << std::endl;
     std::cout << "  Average time: " << (horizontal_remove_calls > 0 ? total_horizontal_remove_time / horizontal_remove_calls : 0) << "s" << std::endl;
 
-    double total_processing_time = total_energy_time + total_vertical_seam_time + total_horizontal_seam_time +
-        total_vertical_remove_time + total_horizontal_remove_time;
+    if (transpose_calls > 0)
+    {
+        std::cout << "\nTransposition:" << std::endl;
+        std::cout << "  Calls: " << transpose_calls << std::endl;
+        std::cout << "  Total time: " << total_transpose_time << "s" << std::endl;
+    }
+
+    double total_processing_time = total_energy_time + total_energy_update_time + total_vertical_seam_time + total_horizontal_seam_time +
+        total_vertical_remove_time + total_horizontal_remove_time + total_transpose_time;
     std::cout << "\nTOTAL PROCESSING TIME: " << total_processing_time << "s" << std::endl;
 }
 
+#ifndef VISUALISE
 /**
  * @brief Draws seam onto an image for visualization.
  * Marks each pixel of the seam in red (BGR: 0, 0, 255).
@@ -107,123 +129,582 @@ static void drawSeamOnImage(cv::Mat& img, const std::vector<int>& seam, bool ver
         }
     }
 }
+#endif
 
 /**
  * @brief Resets all timing counters before a new resize operation.
  */
 void resetTiming() {
     total_energy_time = 0.0;
+    total_energy_update_time = 0.0;
     total_vertical_seam_time = 0.0;
     total_horizontal_seam_time = 0.0;
     total_vertical_remove_time = 0.0;
     total_horizontal_remove_time = 0.0;
+    total_transpose_time = 0.0;
     energy_calls = 0;
+    energy_update_calls = 0;
     vertical_seam_calls = 0;
     horizontal_seam_calls = 0;
     vertical_remove_calls = 0;
     horizontal_remove_calls = 0;
+    transpose_calls = 0;
+}
+
+/**
+ * @brief Removes one or more vertical seams from a set of layers (image, gray, energy map, mask).
+ * The layers are compacted in place: in every row the seam columns are sorted and
+ * each run right of a seam is moved left (one memmove per run, the run before the
+ * first seam stays put). The layers then become column ROIs of the same buffers, so
+ * the row stride stays fixed and nothing is allocated or copied twice.
+ *
+ * @param layers Layers to compact; each becomes a view seams.size() columns narrower.
+ * @param seams  Seams to remove, each a vector of x-coordinates (one per row); seams must not
+ *               share a pixel.
+ */
+static void removeVerticalSeamsFromLayers(const std::vector<cv::Mat*>& layers, const std::vector<std::vector<int>>& seams)
+{
+    const int rows = layers[0]->rows;
+    const int cols = layers[0]->cols;
+    const int count = static_cast<int>(seams.size());
+
+    // Remove the seams
+    std::vector<int> seamCols(count);
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int s = 0; s < count; ++s)
+            seamCols[s] = seams[s][i];
+        std::sort(seamCols.begin(), seamCols.end());
+
+        for (cv::Mat* layer : layers)
+        {
+            uchar* row = layer->ptr(i);
+            const size_t pixelSize = layer->elemSize();
+
+            // Move the run after each seam left by the number of seams up to it
+            for (int s = 0; s < count; ++s)
+            {
+                int begin = seamCols[s] + 1;
+                int end = (s + 1 < count) ? seamCols[s + 1] : cols;
+                if (end > begin)
+                    std::memmove(row + (begin - s - 1) * pixelSize, row + begin * pixelSize, (end - begin) * pixelSize);
+            }
+        }
+    }
+
+    for (cv::Mat* layer : layers)
+        *layer = (*layer)(cv::Range::all(), cv::Range(0, cols - count));
+}
+
+/**
+ * @brief Removes one or more horizontal seams from a set of layers (image, gray, energy map, mask).
+ * The layers are compacted in place, top to bottom: every pixel that is not on a
+ * seam moves up by the number of seams above it in its column, copied in runs of
+ * consecutive columns with the same shift; rows above the highest seam pixel are
+ * not touched. Each row is read once whatever the number of seams, and the layers
+ * then become row ROIs of the same buffers.
+ *
+ * @param layers Layers to compact; each becomes a view seams.size() rows shorter.
+ * @param seams  Seams to remove, each a vector of y-coordinates (one per column); seams must not
+ *               share a pixel.
+ */
+static void removeHorizontalSeamsFromLayers(const std::vector<cv::Mat*>& layers, const std::vector<std::vector<int>>& seams)
+{
+    const int rows = layers[0]->rows;
+    const int cols = layers[0]->cols;
+    const int count = static_cast<int>(seams.size());
+
+    // Sorted seam rows of every column
+    std::vector<int> seamRows(static_cast<size_t>(cols) * count);
+    int top = rows;
+    for (int x = 0; x < cols; ++x)
+    {
+        int* colRows = &seamRows[static_cast<size_t>(x) * count];
+        for (int s = 0; s < count; ++s)
+            colRows[s] = seams[s][x];
+        std::sort(colRows, colRows + count);
+        top = std::min(top, colRows[0]);
+    }
+
+    // shift[x]: seams above the current row in column x
+    std::vector<int> shift(cols, 0);
+    std::vector<uchar> onSeam(cols);
+
+    // Remove the seams
+    for (int y = top; y < rows; ++y)
+    {
+        for (int x = 0; x < cols; ++x)
+            onSeam[x] = shift[x] < count && seamRows[static_cast<size_t>(x) * count + shift[x]] == y;
+
+        for (int x = 0; x < cols; )
+        {
+            // Run of columns moving up by the same number of rows
+            const int d = shift[x];
+            if (onSeam[x] || d == 0)
+            {
+                ++x;
+                continue;
+            }
+            int end = x + 1;
+            while (end < cols && !onSeam[end] && shift[end] == d)
+                ++end;
+
+            for (cv::Mat* layer : layers)
+            {
+                const size_t pixelSize = layer->elemSize();
+                std::memcpy(layer->ptr(y - d) + x * pixelSize, layer->ptr(y) + x * pixelSize, (end - x) * pixelSize);
+            }
+            x = end;
+        }
+
+        for (int x = 0; x < cols; ++x)
+            shift[x] += onSeam[x];
+    }
+
+    for (cv::Mat* layer : layers)
+        *layer = layer->rowRange(0, rows - count);
+}
+
+/**
+ * @brief Checks a batch of seams before removal.
+ * Every seam needs one position per line inside the image and 8-connected steps
+ * (the energy refresh relies on it), and no two seams may share a pixel.
+ *
+ * @param seams  Seams to check.
+ * @param length Number of lines (rows for vertical seams, columns for horizontal ones).
+ * @param extent Positions per line.
+ */
+static void checkSeams(const std::vector<std::vector<int>>& seams, int length, int extent)
+{
+    CV_Assert(!seams.empty() && static_cast<int>(seams.size()) < extent);
+    for (const std::vector<int>& seam : seams)
+    {
+        CV_Assert(static_cast<int>(seam.size()) == length);
+        for (int k = 0; k < length; ++k)
+            CV_Assert(seam[k] >= 0 && seam[k] < extent && (k == 0 || std::abs(seam[k] - seam[k - 1]) <= 1));
+    }
+
+    std::vector<int> line(seams.size());
+    for (int k = 0; k < length; ++k)
+    {
+        for (size_t s = 0; s < seams.size(); ++s)
+            line[s] = seams[s][k];
+        std::sort(line.begin(), line.end());
+        CV_Assert(std::adjacent_find(line.begin(), line.end()) == line.end());
+    }
+}
+
+/**
+ * @brief Updates an integral image after a vertical seam was removed from its source.
+ * Integral row Y only depends on source rows [0, Y): columns up to the leftmost seam
+ * pixel of those rows are unchanged and not touched, columns right of the rightmost
+ * one are the old entries shifted left by one minus the removed values, and only the
+ * columns in between are rebuilt from the compacted gray image with the integral
+ * recurrence. The update runs in place, top to bottom and left to right: a row only
+ * reads the updated row above and old entries right of the one it writes. The
+ * integral then becomes a column ROI of the same buffer.
+ *
+ * @param integral CV_64F integral of the source; becomes a view one column narrower.
+ * @param gray     Compacted 8-bit gray image.
+ * @param seam     Vector of x-coordinates specifying the seam path.
+ * @param removed  Gray value of each removed seam pixel.
+ * @param squared  True for the integral of squared gray values.
+ */
+static void removeVerticalSeamFromIntegral(cv::Mat& integral, const cv::Mat& gray, const std::vector<int>& seam,
+                                           const std::vector<uchar>& removed, bool squared)
+{
+    const int rows = integral.rows;
+    const int cols = integral.cols - 1;
+
+    int lo = cols;
+    int hi = -1;
+    double removedSum = 0.0;
+    for (int Y = 1; Y < rows; ++Y)
+    {
+        const int s = seam[Y - 1];
+        const double v = removed[Y - 1];
+        lo = std::min(lo, s);
+        hi = std::max(hi, s);
+        removedSum += squared ? v * v : v;
+
+        const double* up = integral.ptr<double>(Y - 1);
+        double* n = integral.ptr<double>(Y);
+        const uchar* g = gray.ptr<uchar>(Y - 1);
+
+        int X = lo + 1;
+        for (; X <= hi && X < cols; ++X)
+        {
+            const double p = g[X - 1];
+            n[X] = (squared ? p * p : p) + up[X] + n[X - 1] - up[X - 1];
+        }
+        for (; X < cols; ++X)
+            n[X] = n[X + 1] - removedSum;
+    }
+
+    integral = integral.colRange(0, cols);
+}
+
+/**
+ * @brief Updates an integral image after a horizontal seam was removed from its source.
+ * Mirror of removeVerticalSeamFromIntegral(): integral column X only depends on
+ * source columns [0, X), so only the rows between the extreme seam positions of those
+ * columns are rebuilt; rows above are kept and rows below are shifted up by one. Runs
+ * in place from the first row any seam reaches; the integral then becomes a row ROI of
+ * the same buffer.
+ *
+ * @param integral CV_64F integral of the source; becomes a view one row shorter.
+ * @param gray     Compacted 8-bit gray image.
+ * @param seam     Vector of y-coordinates specifying the seam path.
+ * @param removed  Gray value of each removed seam pixel.
+ * @param squared  True for the integral of squared gray values.
+ */
+static void removeHorizontalSeamFromIntegral(cv::Mat& integral, const cv::Mat& gray, const std::vector<int>& seam,
+                                             const std::vector<uchar>& removed, bool squared)
+{
+    const int rows = integral.rows - 1;
+    const int cols = integral.cols;
+
+    // seam extent and removed sum over source columns [0, X)
+    std::vector<int> lo(cols, rows), hi(cols, -1);
+    std::vector<double> removedSum(cols, 0.0);
+    for (int X = 1; X < cols; ++X)
+    {
+        const double v = removed[X - 1];
+        lo[X] = std::min(lo[X - 1], seam[X - 1]);
+        hi[X] = std::max(hi[X - 1], seam[X - 1]);
+        removedSum[X] = removedSum[X - 1] + (squared ? v * v : v);
+    }
+
+    // rows up to the highest seam pixel keep their entries
+    for (int Y = lo[cols - 1] + 1; Y < rows; ++Y)
+    {
+        const double* up = integral.ptr<double>(Y - 1);
+        const double* dn = integral.ptr<double>(Y + 1);
+        double* n = integral.ptr<double>(Y);
+        const uchar* g = gray.ptr<uchar>(Y - 1);
+
+        for (int X = 1; X < cols; ++X)
+        {
+            if (Y <= lo[X])
+                continue;
+            if (Y > hi[X])
+                n[X] = dn[X] - removedSum[X];
+            else
+            {
+                const double p = g[X - 1];
+                n[X] = (squared ? p * p : p) + up[X] + n[X - 1] - up[X - 1];
+            }
+        }
+    }
+
+    integral = integral.rowRange(0, rows);
+}
+
+/**
+ * @brief Adds weighted saliency to row y, columns [x0, x1] of an energy map.
+ * Saliency is in [0, 1]; for CV_16U maps it is scaled by 255 to the 8-bit
+ * gradient units of the integer pipeline.
+ */
+static void addSaliencySpan(cv::Mat& energy, const cv::Mat& saliency, float weight, int y, int x0, int x1)
+{
+    const float* sRow = saliency.ptr<float>(y);
+
+    if (energy.depth() == CV_16U)
+    {
+        ushort* eRow = energy.ptr<ushort>(y);
+        const float scale = weight * 255.0f;
+        for (int x = x0; x <= x1; ++x)
+            eRow[x] = cv::saturate_cast<ushort>(eRow[x] + scale * sRow[x]);
+    }
+    else
+    {
+        float* eRow = energy.ptr<float>(y);
+        for (int x = x0; x <= x1; ++x)
+            eRow[x] += weight * sRow[x];
+    }
 }
 
 /**
  * @brief Computes the energy map of the current image.
+ * Also refreshes the cached grayscale image used for incremental updates.
  * @return A single-channel floating-point matrix representing per-pixel energy.
  */
 cv::Mat SeamCarver::computeEnergyMap()
 {
     auto start = std::chrono::high_resolution_clock::now();
 
-    //convert image to grayscale
-    cv::Mat gray;
-    cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
-    gray.convertTo(gray, CV_32F, 1.0 / 255.0);
+    cv::Mat energyMap;
+    const int energyType = integerEnergy ? CV_16U : CV_32F;
 
-    // use Sobel to calculate the gradient of the image in the x and y direction
-    cv::Mat grayX, grayY;
-    cv::Sobel(gray, grayX, CV_32F, 1, 0, 3);
-    cv::Sobel(gray, grayY, CV_32F, 0, 1, 3);
+    if (varianceRadius > 0)
+    {
+        // local variance: gray and its integral images (both kept for incremental
+        // updates), then four integral reads per pixel whatever the window size
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+        cv::integral(gray, graySum, graySqSum, CV_64F, CV_64F);
+        energyMap.create(image.size(), CV_32F);
+        computeLocalVarianceRows(graySum, graySqSum, energyMap, varianceRadius, 0, image.rows);
+    }
+    else if (!energyKernels.builtin)
+    {
+        // energy functor policy: gray first (also needed for incremental updates),
+        // then the functor's specialised row kernel
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+        energyMap.create(image.size(), CV_32F);
+        if (energyEngine == EnergyEngine::Parallel)
+            computeEnergyParallel(energyKernels.rows, image, gray, energyMap);
+        else
+            energyKernels.rows(image, gray, energyMap, 0, image.rows);
+    }
+    else if (energyEngine == EnergyEngine::Fused)
+    {
+        // single pass: gray, Sobel and magnitude are fused per row
+        gray.create(image.size(), CV_8U);
+        energyMap.create(image.size(), energyType);
+        computeSobelEnergyRows(image, gray, energyMap, 0, image.rows);
+    }
+    else if (energyEngine == EnergyEngine::Parallel)
+    {
+        // fused kernel on independent stripes, one thread per stripe
+        gray.create(image.size(), CV_8U);
+        energyMap.create(image.size(), energyType);
+        computeEnergyParallel(computeSobelEnergyRows, image, gray, energyMap);
+    }
+    else if (integerEnergy)
+    {
+        // integer pipeline: 8-bit gray, int16 Sobel, L1 magnitude as uint16
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+
+        cv::Mat gradX, gradY;
+        cv::Sobel(gray, gradX, CV_16S, 1, 0, 3);
+        cv::Sobel(gray, gradY, CV_16S, 0, 1, 3);
+
+        cv::absdiff(gradX, cv::Scalar::all(0), gradX);
+        cv::absdiff(gradY, cv::Scalar::all(0), gradY);
+        cv::add(gradX, gradY, energyMap, cv::noArray(), CV_16U);
+    }
+    else
+    {
+        //convert image to grayscale (the 8-bit copy is kept for incremental updates)
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+        cv::Mat grayF;
+        gray.convertTo(grayF, CV_32F, 1.0 / 255.0);
+
+        // use Sobel to calculate the gradient of the image in the x and y direction
+        cv::Mat grayX, grayY;
+        cv::Sobel(grayF, grayX, CV_32F, 1, 0, 3);
+        cv::Sobel(grayF, grayY, CV_32F, 0, 1, 3);
+
+        // compute the energy map as the sum of the absolute values of the gradients
+        cv::magnitude(grayX, grayY, energyMap);
+    }
 
-    cv::Mat energy;
-    // compute the energy map as the sum of the absolute values of the gradients
-    cv::magnitude(grayX, grayY, energy);
+    // blend in the per-job saliency layer (compacted together with the image)
+    if (!saliency.empty())
+    {
+        for (int y = 0; y < energyMap.rows; ++y)
+            addSaliencySpan(energyMap, saliency, saliencyWeight, y, 0, energyMap.cols - 1);
+    }
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end - start;
     total_energy_time += duration.count();
     energy_calls++;
 
+    return energyMap;
+}
+
+/**
+ * @brief Returns the energy map for the current image.
+ * In incremental mode the persistent map is reused and only rebuilt when it
+ * is not in sync with the image; otherwise a fresh map is computed.
+ * Forward-energy jobs keep gray in sync instead and return an empty map.
+ */
+const cv::Mat& SeamCarver::currentEnergyMap()
+{
+    // Lazy energy keeps no map; the seam finders probe the pixels they read
+    if (lazyEnergy)
+        return energy;
+
+    // Forward energy is computed from gray inside the DP; gray is compacted with the image
+    if (grayOnly)
+    {
+        if (!incrementalEnergy || !energyValid)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+            energyValid = incrementalEnergy;
+            std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+            total_energy_time += duration.count();
+            energy_calls++;
+        }
+        return energy;
+    }
+
+    if (!incrementalEnergy || !energyValid)
+    {
+        energy = computeEnergyMap();
+        energyValid = incrementalEnergy;
+        dpCache.valid = false;
+    }
     return energy;
 }
 
 /**
- * @brief Finds a vertical seam of minimum energy.
- * A vertical seam is one pixel per row, connected from top to bottom.
+ * @brief Recomputes the energy of row y for columns [x0, x1] from the cached gray image.
+ * Uses the same Sobel/magnitude formula (with reflected borders) as computeEnergyMap().
+ */
+void SeamCarver::refreshEnergySpan(int y, int x0, int x1)
+{
+    if (varianceRadius > 0)
+    {
+        float* eRow = energy.ptr<float>(y);
+        for (int x = x0; x <= x1; ++x)
+            eRow[x] = localVarianceEnergyAt(graySum, graySqSum, y, x, varianceRadius);
+    }
+    else if (!energyKernels.builtin)
+    {
+        energyKernels.span(image, gray, energy, y, x0, x1);
+    }
+    else
+    {
+        const int rows = gray.rows;
+        const int cols = gray.cols;
+
+        const uchar* up  = gray.ptr<uchar>(reflectBorder(y - 1, rows));
+        const uchar* mid = gray.ptr<uchar>(y);
+        const uchar* dn  = gray.ptr<uchar>(reflectBorder(y + 1, rows));
+
+        if (energy.depth() == CV_16U)
+        {
+            ushort* eRow = energy.ptr<ushort>(y);
+            for (int x = x0; x <= x1; ++x)
+                eRow[x] = sobelL1EnergyAt(up, mid, dn, reflectBorder(x - 1, cols), x, reflectBorder(x + 1, cols));
+        }
+        else
+        {
+            float* eRow = energy.ptr<float>(y);
+            for (int x = x0; x <= x1; ++x)
+                eRow[x] = sobelEnergyAt(up, mid, dn, reflectBorder(x - 1, cols), x, reflectBorder(x + 1, cols));
+        }
+    }
+
+    if (!saliency.empty())
+        addSaliencySpan(energy, saliency, saliencyWeight, y, x0, x1);
+}
+
+/**
+ * @brief Seam cost of n pixels evaluated on demand (lazy energy).
+ * Saliency is added like addSaliencySpan() (saturated to uint16 for the integer
+ * energy), then the mask bias like the seam finders.
+ */
+void SeamCarver::probeSeamCost(const cv::Point* pixels, int n, float* cost) const
+{
+    energyProbe(image, pixels, n, cost);
+
+    if (!saliency.empty())
+    {
+        const bool integer = energyKernels.builtin && integerEnergy;
+        const float scale = integer ? saliencyWeight * 255.0f : saliencyWeight;
+        for (int i = 0; i < n; ++i)
+        {
+            const float e = cost[i] + scale * saliency.at<float>(pixels[i]);
+            cost[i] = integer ? cv::saturate_cast<ushort>(e) : e;
+        }
+    }
+    if (!mask.empty())
+    {
+        for (int i = 0; i < n; ++i)
+            cost[i] += maskBias[mask.at<uchar>(pixels[i])];
+    }
+}
+
+/**
+ * @brief Cumulative seam cost of the DPs: float, or double while a mask is set.
+ * The mask bias outweighs the energy of any seam, so masked costs grow to about
+ * bias * H, where float would round away the energy differences between seams.
+ */
+template <bool Masked>
+using SeamCost = typename std::conditional<Masked, double, float>::type;
+
+/**
+ * @brief Finds a vertical seam minimising forward energy (Rubinstein et al. 2008).
+ * Removing pixel (y, x) joins its left and right neighbours (cost C_U); a diagonal
+ * step additionally joins the pixel above with the new left or right neighbour
+ * (costs C_L / C_R). The costs are computed on the fly from the gray rows inside
+ * the DP row loop, so no cost maps are materialised. Borders are replicated so that
+ * edge pixels are not free to remove (which would pull seams onto the border).
  *
- * @param energy Pre-computed energy map of the image.
+ * @param gray 8-bit luminance of the current image.
+ * @param mask MaskLabel layer (read only when Masked).
+ * @param bias Additive cost per MaskLabel.
  * @return Vector of x-coordinates for each row indicating the seam position.
  */
-std::vector<int> SeamCarver::findVerticalSeam(const cv::Mat& energy)
+template <bool Masked>
+static std::vector<int> findVerticalSeamForward(const cv::Mat& gray, const cv::Mat& mask, const float* bias)
 {
-    auto start = std::chrono::high_resolution_clock::now();
-
-#ifdef USE_DP
-    // -------------------- DYNAMIC PROGRAMMING VERSION --------------------
-    const int rows = energy.rows;
-    const int cols = energy.cols;
+    const int rows = gray.rows;
+    const int cols = gray.cols;
 
     if (rows == 0 || cols == 0)
         return std::vector<int>();
 
-    if (rows == 1) {
-        double minVal;
-        cv::Point minLoc;
-        cv::minMaxLoc(energy.row(0), &minVal, nullptr, &minLoc, nullptr);
-        return std::vector<int>(1, minLoc.x);
-    }
-
     const int size = rows * cols;
+    using Cost = SeamCost<Masked>;
 
-    // DP and parent in 1D (row-major)
-    std::vector<float> dp(size);
-    std::vector<int> parent(size, -1);
+    std::vector<Cost> dp(size);
+    std::vector<schar> parent(size, 0); // parent offset -1 / 0 / +1
 
     //Lambda to do 1D array instead of vector
     auto idx = [cols](int r, int c) { return r * cols + c; };
 
-    // first row: dp(0,x) = energy(0,x)
-    const float* eRow0 = energy.ptr<float>(0);
+    // first row: only the horizontal join C_U
+    const uchar* g0 = gray.ptr<uchar>(0);
     for (int x = 0; x < cols; ++x) {
-        dp[idx(0, x)] = eRow0[x];
+        dp[idx(0, x)] = static_cast<Cost>(std::abs(g0[std::min(x + 1, cols - 1)] - g0[std::max(x - 1, 0)]));
+        if (Masked)
+            dp[idx(0, x)] += bias[mask.at<uchar>(0, x)];
     }
 
-    constexpr float INF = std::numeric_limits<float>::infinity();
-
-    // DP: from second row to last
     for (int y = 1; y < rows; ++y) {
-        const float* eRow = energy.ptr<float>(y);
+        const uchar* up = gray.ptr<uchar>(y - 1);
+        const uchar* mid = gray.ptr<uchar>(y);
+        const uchar* mRow = Masked ? mask.ptr<uchar>(y) : nullptr;
         for (int x = 0; x < cols; ++x) {
-            // candidates from row y-1
-            float bestCost = dp[idx(y - 1, x)];
+            const int left = mid[std::max(x - 1, 0)];
+            const int right = mid[std::min(x + 1, cols - 1)];
+            Cost cU = static_cast<Cost>(std::abs(right - left));
+            if (Masked)
+                cU += bias[mRow[x]];
+
+            Cost bestCost = dp[idx(y - 1, x)] + cU;
             int   bestX = x;
 
-            if (x > 0 && dp[idx(y - 1, x - 1)] < bestCost) {
-                bestCost = dp[idx(y - 1, x - 1)];
-                bestX = x - 1;
+            if (x > 0) {
+                Cost cL = dp[idx(y - 1, x - 1)] + cU + std::abs(up[x] - left);
+                if (cL < bestCost) {
+                    bestCost = cL;
+                    bestX = x - 1;
+                }
             }
-            if (x + 1 < cols && dp[idx(y - 1, x + 1)] < bestCost) {
-                bestCost = dp[idx(y - 1, x + 1)];
-                bestX = x + 1;
+            if (x + 1 < cols) {
+                Cost cR = dp[idx(y - 1, x + 1)] + cU + std::abs(up[x] - right);
+                if (cR < bestCost) {
+                    bestCost = cR;
+                    bestX = x + 1;
+                }
             }
 
-            dp[idx(y, x)] = eRow[x] + bestCost;
-            parent[idx(y, x)] = bestX;
+            dp[idx(y, x)] = bestCost;
+            parent[idx(y, x)] = static_cast<schar>(bestX - x);
         }
     }
 
     // find minimum in last row
-    float minCost = dp[idx(rows - 1, 0)];
+    Cost minCost = dp[idx(rows - 1, 0)];
     int minIndex = 0;
     for (int x = 1; x < cols; ++x) {
-        float v = dp[idx(rows - 1, x)];
+        Cost v = dp[idx(rows - 1, x)];
         if (v < minCost) {
             minCost = v;
             minIndex = x;
@@ -235,62 +716,1421 @@ std::vector<int> SeamCarver::findVerticalSeam(const cv::Mat& energy)
     int x = minIndex;
     for (int y = rows - 1; y >= 0; --y) {
         seam[y] = x;
-        int p = parent[idx(y, x)];
-        x = p;
+        x += parent[idx(y, x)];
     }
-#else
-    // -------------------- GREEDY VERSION --------------------
-    const int rows = energy.rows;
-    const int cols = energy.cols;
 
-    std::vector<int> seam(rows);
+    return seam;
+}
 
-    // Start at MIN value in first row
-    double minVal;
-    cv::Point minLoc;
-    cv::minMaxLoc(energy.row(0), &minVal, nullptr, &minLoc, nullptr);
-    int x = minLoc.x;
-    seam[0] = x;
+/**
+ * @brief Finds a horizontal seam minimising forward energy.
+ * Mirror of findVerticalSeamForward(): removing pixel (y, x) joins the pixels above
+ * and below it, and a diagonal step also joins the pixel to its left with the new
+ * upper or lower neighbour.
+ *
+ * @param gray 8-bit luminance of the current image.
+ * @param mask MaskLabel layer (read only when Masked).
+ * @param bias Additive cost per MaskLabel.
+ * @return Vector of y-coordinates for each column indicating the seam position.
+ */
+template <bool Masked>
+static std::vector<int> findHorizontalSeamForward(const cv::Mat& gray, const cv::Mat& mask, const float* bias)
+{
+    const int rows = gray.rows;
+    const int cols = gray.cols;
 
-    // For each row, choose the smallest-energy neighbor
+    if (rows == 0 || cols == 0)
+        return std::vector<int>();
+
+    const int size = rows * cols;
+    using Cost = SeamCost<Masked>;
+
+    std::vector<Cost> dp(size);
+    std::vector<schar> parent(size, 0); // parent offset -1 / 0 / +1
+
+    //Lambda to do 1D array instead of vector
+    auto idx = [cols](int r, int c) { return r * cols + c; };
+
+    // first column: only the vertical join C_U
+    for (int y = 0; y < rows; ++y) {
+        const int above = gray.at<uchar>(std::max(y - 1, 0), 0);
+        const int below = gray.at<uchar>(std::min(y + 1, rows - 1), 0);
+        dp[idx(y, 0)] = static_cast<Cost>(std::abs(below - above));
+        if (Masked)
+            dp[idx(y, 0)] += bias[mask.at<uchar>(y, 0)];
+    }
+
+    for (int x = 1; x < cols; ++x) {
+        for (int y = 0; y < rows; ++y) {
+            const int above = gray.at<uchar>(std::max(y - 1, 0), x);
+            const int below = gray.at<uchar>(std::min(y + 1, rows - 1), x);
+            const int prev = gray.at<uchar>(y, x - 1);
+            Cost cU = static_cast<Cost>(std::abs(below - above));
+            if (Masked)
+                cU += bias[mask.at<uchar>(y, x)];
+
+            Cost bestCost = dp[idx(y, x - 1)] + cU;
+            int   bestY = y;
+
+            if (y > 0) {
+                Cost cL = dp[idx(y - 1, x - 1)] + cU + std::abs(prev - above);
+                if (cL < bestCost) {
+                    bestCost = cL;
+                    bestY = y - 1;
+                }
+            }
+            if (y + 1 < rows) {
+                Cost cR = dp[idx(y + 1, x - 1)] + cU + std::abs(prev - below);
+                if (cR < bestCost) {
+                    bestCost = cR;
+                    bestY = y + 1;
+                }
+            }
+
+            dp[idx(y, x)] = bestCost;
+            parent[idx(y, x)] = static_cast<schar>(bestY - y);
+        }
+    }
+
+    // find minimum in last column
+    Cost minCost = dp[idx(0, cols - 1)];
+    int minIndex = 0;
     for (int y = 1; y < rows; ++y) {
-        int bestX = x;
-        float bestVal = energy.at<float>(y, x);
+        Cost v = dp[idx(y, cols - 1)];
+        if (v < minCost) {
+            minCost = v;
+            minIndex = y;
+        }
+    }
+
+    // backtrack seam (one y index per column)
+    std::vector<int> seam(cols);
+    int y = minIndex;
+    for (int x = cols - 1; x >= 0; --x) {
+        seam[x] = y;
+        y += parent[idx(y, x)];
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Relaxes one row of the vertical DP: cur[x] = energy(x) + min(prev[x-1], prev[x], prev[x+1]).
+ * Float rows run the vectorised kernel of the CPU-selected SimdKernels variant; the
+ * double rows of a masked DP are relaxed by the scalar loop of the same rules (ties
+ * keep the centre, then the left candidate). prev and cur are padded DP rows whose
+ * entries at -1 and cols hold +inf, parents are int8 offsets.
+ *
+ * @param prev   Padded DP row y-1.
+ * @param cur    Padded DP row y (written).
+ * @param parent Parent offsets of row y (written).
+ * @param eRow   Energy row y.
+ * @param mRow   MaskLabel row y (read only when Masked).
+ * @param bias   Additive cost per MaskLabel.
+ * @param cols   Row width.
+ */
+template <typename T>
+static inline void relaxCostRow(const float* prev, float* cur, schar* parent, const T* eRow,
+                                const uchar* /*mRow*/, const float* /*bias*/, int cols)
+{
+    simdKernels().relaxRow(eRow)(prev, cur, parent, eRow, cols);
+}
 
-        if (x > 0 && energy.at<float>(y, x - 1) < bestVal) {
-            bestVal = energy.at<float>(y, x - 1);
+template <typename T>
+static inline void relaxCostRow(const double* prev, double* cur, schar* parent, const T* eRow,
+                                const uchar* mRow, const float* bias, int cols)
+{
+    for (int x = 0; x < cols; ++x) {
+        double bestCost = prev[x];
+        int bestX = x;
+        if (prev[x - 1] < bestCost) {
+            bestCost = prev[x - 1];
             bestX = x - 1;
         }
-        if (x + 1 < cols && energy.at<float>(y, x + 1) < bestVal) {
-            bestVal = energy.at<float>(y, x + 1);
+        if (prev[x + 1] < bestCost) {
+            bestCost = prev[x + 1];
             bestX = x + 1;
         }
 
-        x = bestX;
-        seam[y] = x;
+        cur[x] = static_cast<double>(eRow[x]) + bias[mRow[x]] + bestCost;
+        parent[x] = static_cast<schar>(bestX - x);
+    }
+}
+
+template <typename T, bool Masked>
+static inline void relaxVerticalRow(const SeamCost<Masked>* prev, SeamCost<Masked>* cur, schar* parent, const T* eRow,
+                                    const uchar* mRow, const float* bias, int cols)
+{
+    relaxCostRow(prev, cur, parent, eRow, mRow, bias, cols);
+}
+
+/**
+ * @brief Returns the first index of the minimum of v[0..n) (CPU-selected SimdKernels variant).
+ */
+static inline int argminRow(const float* v, int n)
+{
+    return simdKernels().argminRow(v, n);
+}
+
+/**
+ * @brief Returns the first index of the minimum of the double costs v[0..n) of a masked DP.
+ */
+static inline int argminRow(const double* v, int n)
+{
+    return static_cast<int>(std::min_element(v, v + n) - v);
+}
+
+/**
+ * @brief Incremental vertical DP: updates the cached DP after one vertical seam.
+ *
+ * The cached cost/parent arrays have been compacted like the image, so only cells
+ * whose energy was refreshed (cache.energyBand) or whose upper neighbours changed
+ * cost can differ. Row y relaxes the hull of its energy band and the columns changed
+ * in row y-1 widened by one; the changed set shrinks to the cells whose cost really
+ * changed, so the cone stops spreading as soon as the old costs are reproduced.
+ *
+ * @param energy Current energy map.
+ * @param mask   MaskLabel layer (read only when Masked).
+ * @param bias   Additive cost per MaskLabel.
+ * @param cache  Valid DP state of the previous seam (updated).
+ * @return Vector of x-coordinates for each row indicating the seam position.
+ */
+template <typename T, bool Masked>
+static std::vector<int> updateVerticalSeamCone(const cv::Mat& energy, const cv::Mat& mask, const float* bias, SeamDPCache& cache)
+{
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+    using Cost = SeamCost<Masked>;
+
+    // columns of the previous row whose cost changed (empty when lo > hi)
+    int lo = cols;
+    int hi = -1;
+
+    for (int y = 0; y < rows; ++y) {
+        int x0 = cache.energyBand[y][0];
+        int x1 = cache.energyBand[y][1];
+        if (lo <= hi) {
+            x0 = std::min(x0, lo - 1);
+            x1 = std::max(x1, hi + 1);
+        }
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, cols - 1);
+
+        const T* eRow = energy.ptr<T>(y);
+        const uchar* mRow = Masked ? mask.ptr<uchar>(y) : nullptr;
+        const Cost* up = y > 0 ? cache.cost.ptr<Cost>(y - 1) : nullptr;
+        Cost* cur = cache.cost.ptr<Cost>(y);
+        schar* par = cache.parent.ptr<schar>(y);
+
+        lo = cols;
+        hi = -1;
+        for (int x = x0; x <= x1; ++x) {
+            Cost cost = eRow[x];
+            if (Masked)
+                cost += bias[mRow[x]];
+
+            Cost value = cost;
+            int bestX = x;
+            if (up) {
+                Cost bestCost = up[x];
+                if (x > 0 && up[x - 1] < bestCost) {
+                    bestCost = up[x - 1];
+                    bestX = x - 1;
+                }
+                if (x + 1 < cols && up[x + 1] < bestCost) {
+                    bestCost = up[x + 1];
+                    bestX = x + 1;
+                }
+                value = cost + bestCost;
+            }
+
+            par[x] = static_cast<schar>(bestX - x);
+            if (value != cur[x]) {
+                cur[x] = value;
+                lo = std::min(lo, x);
+                hi = x;
+            }
+        }
+    }
+
+    // find minimum in last row
+    int x = argminRow(cache.cost.ptr<Cost>(rows - 1), cols);
+
+    // backtrack seam
+    std::vector<int> seam(rows);
+    for (int y = rows - 1; y >= 0; --y) {
+        seam[y] = x;
+        x += cache.parent.at<schar>(y, x);
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Implementation of SeamCarver::findVerticalSeam for an energy map of element type T
+ * (float for CV_32F maps, ushort for CV_16U maps). Costs are accumulated in SeamCost.
+ * When Masked, bias[mask(y, x)] is added to every energy read.
+ * With a cache, a valid DP state is updated in place (updateVerticalSeamCone());
+ * otherwise the full DP runs and its cost/parent arrays are stored in the cache.
+ */
+template <typename T, bool Masked>
+static std::vector<int> findVerticalSeamImpl(const cv::Mat& energy, const cv::Mat& mask, const float* bias, SeamDPCache* cache)
+{
+    // -------------------- DYNAMIC PROGRAMMING VERSION --------------------
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+
+    if (rows == 0 || cols == 0)
+        return std::vector<int>();
+
+    if (cache && cache->valid)
+        return updateVerticalSeamCone<T, Masked>(energy, mask, bias, *cache);
+
+    if (rows == 1 && !Masked && !cache) {
+        double minVal;
+        cv::Point minLoc;
+        cv::minMaxLoc(energy.row(0), &minVal, nullptr, &minLoc, nullptr);
+        return std::vector<int>(1, minLoc.x);
+    }
+
+    const int size = rows * cols;
+    using Cost = SeamCost<Masked>;
+    constexpr Cost INF = std::numeric_limits<Cost>::infinity();
+
+    // DP rows padded with one +inf column on each side (no edge checks in the
+    // row kernel), parent offsets in 1D (row-major)
+    const int stride = cols + 2;
+    std::vector<Cost> dp(rows * stride, INF);
+    std::vector<schar> parent(size, 0); // parent offset -1 / 0 / +1
+
+    //Lambda to do 1D array instead of vector
+    auto idx = [cols](int r, int c) { return r * cols + c; };
+    auto dpRow = [&dp, stride](int r) { return dp.data() + r * stride + 1; };
+
+    // first row: dp(0,x) = energy(0,x)
+    const T* eRow0 = energy.ptr<T>(0);
+    Cost* dp0 = dpRow(0);
+    for (int x = 0; x < cols; ++x) {
+        dp0[x] = eRow0[x];
+        if (Masked)
+            dp0[x] += bias[mask.at<uchar>(0, x)];
+    }
+
+    // DP: from second row to last, one vectorised row relaxation per row
+    for (int y = 1; y < rows; ++y) {
+        relaxVerticalRow<T, Masked>(dpRow(y - 1), dpRow(y), &parent[idx(y, 0)], energy.ptr<T>(y),
+                                    Masked ? mask.ptr<uchar>(y) : nullptr, bias, cols);
+    }
+
+    // find minimum in last row
+    int minIndex = argminRow(dpRow(rows - 1), cols);
+
+    // keep the DP for the next seam
+    if (cache) {
+        cache->cost.create(rows, cols, cv::traits::Type<Cost>::value);
+        cache->parent.create(rows, cols, CV_8S);
+        for (int y = 0; y < rows; ++y) {
+            std::copy(dpRow(y), dpRow(y) + cols, cache->cost.ptr<Cost>(y));
+            std::copy(&parent[idx(y, 0)], &parent[idx(y, 0)] + cols, cache->parent.ptr<schar>(y));
+        }
+        cache->valid = true;
+    }
+
+    // backtrack seam
+    std::vector<int> seam(rows);
+    int x = minIndex;
+    for (int y = rows - 1; y >= 0; --y) {
+        seam[y] = x;
+        x += parent[idx(y, x)];
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Greedy vertical seam for an energy map of element type T: starts at the
+ * cheapest pixel of the first row and steps to the cheapest of the three pixels below.
+ * When Masked, bias[mask(y, x)] is added to every energy read.
+ */
+template <typename T, bool Masked>
+static std::vector<int> findVerticalSeamGreedyImpl(const cv::Mat& energy, const cv::Mat& mask, const float* bias)
+{
+    // -------------------- GREEDY VERSION --------------------
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+
+    std::vector<int> seam(rows);
+
+    //Lambda to read the (mask-biased) energy of a pixel
+    auto cost = [&](int r, int c) {
+        float e = energy.at<T>(r, c);
+        if (Masked)
+            e += bias[mask.at<uchar>(r, c)];
+        return e;
+    };
+
+    // Start at MIN value in first row
+    int x = 0;
+    if (Masked) {
+        for (int c = 1; c < cols; ++c)
+            if (cost(0, c) < cost(0, x))
+                x = c;
+    }
+    else {
+        double minVal;
+        cv::Point minLoc;
+        cv::minMaxLoc(energy.row(0), &minVal, nullptr, &minLoc, nullptr);
+        x = minLoc.x;
+    }
+    seam[0] = x;
+
+    // For each row, choose the smallest-energy neighbor
+    for (int y = 1; y < rows; ++y) {
+        int bestX = x;
+        float bestVal = cost(y, x);
+
+        if (x > 0 && cost(y, x - 1) < bestVal) {
+            bestVal = cost(y, x - 1);
+            bestX = x - 1;
+        }
+        if (x + 1 < cols && cost(y, x + 1) < bestVal) {
+            bestVal = cost(y, x + 1);
+            bestX = x + 1;
+        }
+
+        x = bestX;
+        seam[y] = x;
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Low-memory DP over `lines` lines of `len` entries (rows for vertical seams,
+ * columns for horizontal ones), each relaxed from the previous line.
+ *
+ * Only two DP lines are live during the forward pass; every step-th line
+ * (step = ceil(sqrt(lines))) is saved as a checkpoint. Backtracking walks the
+ * segments from the last to the first, recomputing each segment from its checkpoint
+ * to get its int8 parents. Memory is O(len * sqrt(lines)) instead of O(len * lines)
+ * for about one extra DP pass; the seam is identical to the full DP.
+ *
+ * @param lines      Number of lines (seam length).
+ * @param len        Entries per line.
+ * @param energyLine energyLine(i, buf) returns line i of the energy as float
+ *                   (pointing into the map or filled into buf).
+ * @param maskLine   maskLine(i, buf) returns line i of the MaskLabel layer (only called when Masked).
+ * @param bias       Additive cost per MaskLabel.
+ * @return One index per line.
+ */
+template <bool Masked, class EnergyLine, class MaskLine>
+static std::vector<int> findSeamCheckpointed(int lines, int len, EnergyLine energyLine, MaskLine maskLine, const float* bias)
+{
+    if (lines == 0 || len == 0)
+        return std::vector<int>();
+
+    using Cost = SeamCost<Masked>;
+    constexpr Cost INF = std::numeric_limits<Cost>::infinity();
+    const int step = std::max(1, cvCeil(std::sqrt(static_cast<double>(lines))));
+    const int stride = len + 2;
+    const int checkpoints = (lines - 1) / step + 1;
+
+    // padded DP lines (+inf at -1 and len): checkpoints and the rolling pair
+    std::vector<Cost> saved(checkpoints * stride, INF);
+    std::vector<Cost> rolling(2 * stride, INF);
+    std::vector<schar> parent(step * len); // parent offsets of one segment
+    std::vector<float> eBuf(len);
+    std::vector<uchar> mBuf(len);
+
+    auto savedLine = [&saved, stride](int k) { return saved.data() + k * stride + 1; };
+    auto rollingLine = [&rolling, stride](int i) { return rolling.data() + (i & 1) * stride + 1; };
+
+    // first line: dp(0,x) = energy(0,x)
+    {
+        const float* e = energyLine(0, eBuf.data());
+        const uchar* m = Masked ? maskLine(0, mBuf.data()) : nullptr;
+        Cost* dp0 = savedLine(0);
+        for (int x = 0; x < len; ++x) {
+            dp0[x] = e[x];
+            if (Masked)
+                dp0[x] += bias[m[x]];
+        }
+    }
+
+    // relaxes lines (first, last] starting from dp line `first`; returns dp line `last`
+    auto relaxSegment = [&](int first, int last, const Cost* start) {
+        const Cost* prev = start;
+        for (int i = first + 1; i <= last; ++i) {
+            Cost* cur = rollingLine(i);
+            relaxVerticalRow<float, Masked>(prev, cur, &parent[(i - first - 1) * len], energyLine(i, eBuf.data()),
+                                            Masked ? maskLine(i, mBuf.data()) : nullptr, bias, len);
+            prev = cur;
+        }
+        return prev;
+    };
+
+    // forward pass, saving every step-th line
+    const Cost* last = savedLine(0);
+    for (int first = 0; first < lines - 1; first += step) {
+        const int end = std::min(first + step, lines - 1);
+        last = relaxSegment(first, end, savedLine(first / step));
+        if (end % step == 0)
+            std::copy(last, last + len, savedLine(end / step));
+    }
+
+    // backtrack seam, recomputing the parents of one segment at a time
+    std::vector<int> seam(lines);
+    int x = argminRow(last, len);
+    int y = lines - 1;
+    seam[y] = x;
+    while (y > 0) {
+        const int first = (y - 1) / step * step;
+        relaxSegment(first, y, savedLine(first / step));
+        for (int i = y; i > first; --i) {
+            x += parent[(i - first - 1) * len + x];
+            seam[i - 1] = x;
+        }
+        y = first;
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Returns energy row y as float: the row itself for CV_32F maps, converted into buf otherwise.
+ */
+static inline const float* energyRowAsFloat(const cv::Mat& energy, int y, float* buf)
+{
+    if (energy.depth() == CV_32F)
+        return energy.ptr<float>(y);
+
+    const ushort* eRow = energy.ptr<ushort>(y);
+    for (int x = 0; x < energy.cols; ++x)
+        buf[x] = eRow[x];
+    return buf;
+}
+
+/**
+ * @brief Low-memory version of findVerticalSeamImpl() (see findSeamCheckpointed()).
+ */
+template <bool Masked>
+static std::vector<int> findVerticalSeamCheckpointed(const cv::Mat& energy, const cv::Mat& mask, const float* bias)
+{
+    return findSeamCheckpointed<Masked>(energy.rows, energy.cols,
+        [&energy](int y, float* buf) { return energyRowAsFloat(energy, y, buf); },
+        [&mask](int y, uchar*) { return mask.ptr<uchar>(y); },
+        bias);
+}
+
+/**
+ * @brief Low-memory version of findHorizontalSeamImpl() (see findSeamCheckpointed()).
+ * Columns of the energy map and mask are gathered into contiguous lines.
+ */
+template <bool Masked>
+static std::vector<int> findHorizontalSeamCheckpointed(const cv::Mat& energy, const cv::Mat& mask, const float* bias)
+{
+    return findSeamCheckpointed<Masked>(energy.cols, energy.rows,
+        [&energy](int x, float* buf) {
+            for (int y = 0; y < energy.rows; ++y)
+                buf[y] = (energy.depth() == CV_16U) ? energy.at<ushort>(y, x) : energy.at<float>(y, x);
+            return static_cast<const float*>(buf);
+        },
+        [&mask](int x, uchar* buf) {
+            for (int y = 0; y < mask.rows; ++y)
+                buf[y] = mask.at<uchar>(y, x);
+            return static_cast<const uchar*>(buf);
+        },
+        bias);
+}
+
+/**
+ * @brief Vertical DP restricted to a corridor of +-halfWidth columns around a predicted seam.
+ * Each row only relaxes the columns of its corridor with relaxVerticalRow(); the previous
+ * corridor row is shifted into the column range of the current one (+inf outside it), and
+ * only two DP rows plus the corridor's parent offsets are kept, so a pass costs O(H * band)
+ * instead of O(H * W). The predicted seam itself lies inside the corridor, so a path always
+ * exists. If the best path touches a corridor edge that is not the image border, or crosses
+ * a protected pixel, a better path may lie outside it and the DP is repeated with the
+ * corridor doubled.
+ *
+ * @param predicted Predicted x-coordinate per row (connected, e.g. the previous seam).
+ * @param halfWidth Initial corridor half-width.
+ */
+template <typename T, bool Masked>
+static std::vector<int> findVerticalSeamBanded(const cv::Mat& energy, const cv::Mat& mask, const float* bias,
+                                               const std::vector<int>& predicted, int halfWidth)
+{
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+    using Cost = SeamCost<Masked>;
+    constexpr Cost INF = std::numeric_limits<Cost>::infinity();
+
+    std::vector<int> seam(rows);
+    for (int half = std::max(halfWidth, 1); ; half *= 2)
+    {
+        const int width = std::min(2 * half + 1, cols);
+
+        // first corridor column per row, clipped so the corridor stays inside the image
+        std::vector<int> lo(rows);
+        for (int y = 0; y < rows; ++y)
+            lo[y] = std::min(std::max(predicted[y] - half, 0), cols - width);
+
+        // two rolling DP rows and the previous row realigned to the current corridor,
+        // all padded with one +inf column on each side
+        const int stride = width + 2;
+        std::vector<Cost> rowsBuf(2 * stride, INF);
+        std::vector<Cost> aligned(stride, INF);
+        std::vector<schar> parent(static_cast<size_t>(rows) * width, 0);
+        Cost* prev = rowsBuf.data() + 1;
+        Cost* cur = rowsBuf.data() + stride + 1;
+
+        const T* eRow0 = energy.ptr<T>(0) + lo[0];
+        for (int x = 0; x < width; ++x) {
+            prev[x] = eRow0[x];
+            if (Masked)
+                prev[x] += bias[mask.at<uchar>(0, lo[0] + x)];
+        }
+
+        for (int y = 1; y < rows; ++y) {
+            const int shift = lo[y] - lo[y - 1];
+            for (int x = -1; x <= width; ++x) {
+                const int src = x + shift;
+                aligned[x + 1] = (src >= 0 && src < width) ? prev[src] : INF;
+            }
+            relaxVerticalRow<T, Masked>(aligned.data() + 1, cur, &parent[static_cast<size_t>(y) * width],
+                                        energy.ptr<T>(y) + lo[y], Masked ? mask.ptr<uchar>(y) + lo[y] : nullptr,
+                                        bias, width);
+            std::swap(prev, cur);
+        }
+
+        // backtrack seam, noting whether it runs along a corridor edge inside the image
+        // or through a protected pixel that a wider corridor might avoid
+        bool widen = false;
+        int x = lo[rows - 1] + argminRow(prev, width);
+        for (int y = rows - 1; y >= 0; --y) {
+            seam[y] = x;
+            if ((x == lo[y] && lo[y] > 0) || (x == lo[y] + width - 1 && lo[y] + width < cols))
+                widen = true;
+            if (Masked && mask.at<uchar>(y, x) == static_cast<uchar>(MaskLabel::Protect))
+                widen = true;
+            x += parent[static_cast<size_t>(y) * width + (x - lo[y])];
+        }
+
+        if (!widen || width == cols)
+            return seam;
+    }
+}
+
+/**
+ * @brief Multithreaded vertical DP by row-block (min, +) composition.
+ *
+ * The rows are split into blocks of blockHeight rows. A path can move at most one
+ * column per row, so the DP row at the end of a block depends on the DP row above it
+ * only through a band of 2 * blockHeight + 1 columns:
+ *   dpEnd(b) = min over |a - b| <= h of dpAbove(a) + transfer(b, a).
+ * 1. The transfers of all blocks are independent and are built in parallel
+ *    (one small DP cone per start column).
+ * 2. The block-end rows are stitched block after block, each step parallel over columns.
+ * 3. Every block is relaxed again from its stitched upper row with relaxVerticalRow()
+ *    to get parent offsets, again in parallel, and the seam is backtracked as usual.
+ * The work is about blockHeight + 3 sequential DP passes spread over all threads.
+ * Costs equal the sequential DP up to float rounding (exactly for uint16 energy).
+ *
+ * @param blockHeight Rows per block.
+ * @param parent      Receives the parent offsets of every row (row-major, rows * cols).
+ * @param lastRow     Receives the DP costs of the last row.
+ */
+template <typename T, bool Masked>
+static void relaxVerticalBlocked(const cv::Mat& energy, const cv::Mat& mask, const float* bias, int blockHeight,
+                                 std::vector<schar>& parent, std::vector<SeamCost<Masked>>& lastRow)
+{
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+    using Cost = SeamCost<Masked>;
+    const int blocks = (rows + blockHeight - 1) / blockHeight;
+    constexpr Cost INF = std::numeric_limits<Cost>::infinity();
+
+    // 1. per block and end column b, the cheapest path from column b + d - h of the row
+    //    above the block (d in [0, 2h]) to column b of the block's last row
+    std::vector<std::vector<Cost>> transfer(blocks);
+    cv::parallel_for_(cv::Range(0, blocks), [&](const cv::Range& range) {
+        std::vector<Cost> costRows, prevBuf, curBuf;
+        for (int k = range.start; k < range.end; ++k) {
+            const int r0 = k * blockHeight;
+            const int h = std::min(blockHeight, rows - r0);
+            const int width = 2 * h + 1;
+
+            // pixel costs of the block (energy plus mask bias)
+            costRows.resize(static_cast<size_t>(h) * cols);
+            for (int i = 0; i < h; ++i) {
+                const T* eRow = energy.ptr<T>(r0 + i);
+                Cost* cRow = &costRows[static_cast<size_t>(i) * cols];
+                for (int x = 0; x < cols; ++x) {
+                    cRow[x] = eRow[x];
+                    if (Masked)
+                        cRow[x] += bias[mask.at<uchar>(r0 + i, x)];
+                }
+            }
+
+            std::vector<Cost>& t = transfer[k];
+            t.assign(static_cast<size_t>(cols) * width, INF);
+            prevBuf.resize(width + 2);
+            curBuf.resize(width + 2);
+
+            // DP cone from one column of the row above; index j is column src - h + j
+            for (int src = 0; src < cols; ++src) {
+                std::fill(prevBuf.begin(), prevBuf.end(), INF);
+                prevBuf[h + 1] = 0.f;
+                for (int i = 0; i < h; ++i) {
+                    const Cost* prev = prevBuf.data() + 1;
+                    Cost* cur = curBuf.data() + 1;
+                    std::fill(curBuf.begin(), curBuf.end(), INF);
+                    const Cost* cRow = &costRows[static_cast<size_t>(i) * cols];
+                    const int j0 = std::max(h - 1 - i, src - h < 0 ? h - src : 0);
+                    const int j1 = std::min(h + 1 + i, cols - 1 - src + h);
+                    for (int j = j0; j <= j1; ++j)
+                        cur[j] = cRow[src - h + j] + std::min(prev[j], std::min(prev[j - 1], prev[j + 1]));
+                    std::swap(prevBuf, curBuf);
+                }
+                const Cost* prev = prevBuf.data() + 1;
+                for (int j = 0; j < width; ++j) {
+                    const int b = src - h + j;
+                    if (b >= 0 && b < cols)
+                        t[static_cast<size_t>(b) * width + (2 * h - j)] = prev[j];
+                }
+            }
+        }
+    });
+
+    // 2. stitch: boundary[k + 1] is the DP row at the end of block k (boundary[0] is a zero row above the image)
+    std::vector<std::vector<Cost>> boundary(blocks + 1, std::vector<Cost>(cols, 0.f));
+    for (int k = 0; k < blocks; ++k) {
+        const int h = std::min(blockHeight, rows - k * blockHeight);
+        const int width = 2 * h + 1;
+        const std::vector<Cost>& above = boundary[k];
+        const std::vector<Cost>& t = transfer[k];
+        std::vector<Cost>& below = boundary[k + 1];
+        cv::parallel_for_(cv::Range(0, cols), [&](const cv::Range& range) {
+            for (int b = range.start; b < range.end; ++b) {
+                Cost best = INF;
+                const Cost* tRow = &t[static_cast<size_t>(b) * width];
+                for (int d = std::max(h - b, 0); d <= std::min(width - 1, cols - 1 - b + h); ++d)
+                    best = std::min(best, above[b + d - h] + tRow[d]);
+                below[b] = best;
+            }
+        });
+    }
+
+    // 3. relax each block again from its stitched upper row to get the parent offsets
+    parent.assign(static_cast<size_t>(rows) * cols, 0);
+    lastRow.resize(cols);
+    cv::parallel_for_(cv::Range(0, blocks), [&](const cv::Range& range) {
+        std::vector<Cost> prevBuf(cols + 2, INF), curBuf(cols + 2, INF);
+        for (int k = range.start; k < range.end; ++k) {
+            const int r0 = k * blockHeight;
+            const int r1 = std::min(r0 + blockHeight, rows);
+            std::copy(boundary[k].begin(), boundary[k].end(), prevBuf.begin() + 1);
+            for (int y = r0; y < r1; ++y) {
+                relaxVerticalRow<T, Masked>(prevBuf.data() + 1, curBuf.data() + 1, &parent[static_cast<size_t>(y) * cols],
+                                            energy.ptr<T>(y), Masked ? mask.ptr<uchar>(y) : nullptr, bias, cols);
+                std::swap(prevBuf, curBuf);
+            }
+            if (r1 == rows)
+                std::copy(prevBuf.begin() + 1, prevBuf.end() - 1, lastRow.begin());
+        }
+    });
+}
+
+/**
+ * @brief Row-block DP seam (see relaxVerticalBlocked()).
+ */
+template <typename T, bool Masked>
+static std::vector<int> findVerticalSeamBlocked(const cv::Mat& energy, const cv::Mat& mask, const float* bias, int blockHeight)
+{
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+    std::vector<schar> parent;
+    std::vector<SeamCost<Masked>> lastRow;
+    relaxVerticalBlocked<T, Masked>(energy, mask, bias, blockHeight, parent, lastRow);
+
+    // backtrack seam
+    std::vector<int> seam(rows);
+    int x = argminRow(lastRow.data(), cols);
+    for (int y = rows - 1; y >= 0; --y) {
+        seam[y] = x;
+        x += parent[static_cast<size_t>(y) * cols + x];
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Multithreaded vertical DP on column strips, rowsPerStep rows per synchronisation.
+ *
+ * The columns are split into one strip per thread. In each step every strip advances
+ * R = rowsPerStep rows on its own, starting from the shared DP row above the step: to
+ * get its own columns after R rows it needs R extra columns on each side of that row,
+ * and the computed range narrows by one column per side and row (a trapezoid tile).
+ * The halo columns are recomputed by both neighbours, so strips never wait for each
+ * other inside a step and there are H / R barriers instead of H. Each row of a tile is
+ * relaxed with relaxVerticalRow(); only the strip's own parents and last-row costs are
+ * written to the shared arrays. Runs on cv::parallel_for_, whose worker pool is kept
+ * between seams. Seams are identical to the sequential DP.
+ *
+ * @param rowsPerStep Rows per synchronisation step (R).
+ * @param parent      Receives the parent offsets of every row (row-major, rows * cols).
+ * @param lastRow     Receives the DP costs of the last row.
+ */
+template <typename T, bool Masked>
+static void relaxVerticalTiled(const cv::Mat& energy, const cv::Mat& mask, const float* bias, int rowsPerStep,
+                               std::vector<schar>& parent, std::vector<SeamCost<Masked>>& lastRow)
+{
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+    using Cost = SeamCost<Masked>;
+    constexpr Cost INF = std::numeric_limits<Cost>::infinity();
+
+    // one strip per thread, each at least as wide as its two halos
+    const int strips = std::max(1, std::min(cv::getNumThreads(), cols / std::max(2 * rowsPerStep, 1)));
+    const int stripWidth = (cols + strips - 1) / strips;
+
+    parent.assign(static_cast<size_t>(rows) * cols, 0);
+    std::vector<Cost> above(cols, 0.f); // DP row above the current step (a zero row above the image)
+    std::vector<Cost> below(cols);
+
+    for (int y0 = 0; y0 < rows; y0 += rowsPerStep) {
+        const int steps = std::min(rowsPerStep, rows - y0);
+        cv::parallel_for_(cv::Range(0, strips), [&](const cv::Range& range) {
+            std::vector<Cost> prevBuf, curBuf;
+            std::vector<schar> parentBuf;
+            for (int s = range.start; s < range.end; ++s) {
+                const int c0 = s * stripWidth;
+                const int c1 = std::min(c0 + stripWidth, cols);
+                if (c0 >= c1)
+                    continue;
+
+                // tile columns [w0, w1) in the row above, padded with +inf at the image border
+                const int w0 = std::max(c0 - steps, 0);
+                const int w1 = std::min(c1 + steps, cols);
+                prevBuf.assign(w1 - w0 + 2, INF);
+                curBuf.assign(w1 - w0 + 2, INF);
+                parentBuf.resize(w1 - w0);
+                std::copy(above.begin() + w0, above.begin() + w1, prevBuf.begin() + 1);
+
+                for (int i = 0; i < steps; ++i) {
+                    const int y = y0 + i;
+                    const int halo = steps - 1 - i;
+                    const int x0 = std::max(c0 - halo, 0);
+                    const int x1 = std::min(c1 + halo, cols);
+                    relaxVerticalRow<T, Masked>(prevBuf.data() + 1 + (x0 - w0), curBuf.data() + 1 + (x0 - w0),
+                                                parentBuf.data() + (x0 - w0), energy.ptr<T>(y) + x0,
+                                                Masked ? mask.ptr<uchar>(y) + x0 : nullptr, bias, x1 - x0);
+                    std::copy(parentBuf.begin() + (c0 - w0), parentBuf.begin() + (c1 - w0),
+                              parent.begin() + static_cast<size_t>(y) * cols + c0);
+                    std::swap(prevBuf, curBuf);
+                }
+                std::copy(prevBuf.begin() + 1 + (c0 - w0), prevBuf.begin() + 1 + (c1 - w0), below.begin() + c0);
+            }
+        });
+        std::swap(above, below);
+    }
+
+    lastRow.swap(above);
+}
+
+/**
+ * @brief Strip-tiled DP seam (see relaxVerticalTiled()).
+ */
+template <typename T, bool Masked>
+static std::vector<int> findVerticalSeamTiled(const cv::Mat& energy, const cv::Mat& mask, const float* bias, int rowsPerStep)
+{
+    const int rows = energy.rows;
+    const int cols = energy.cols;
+    std::vector<schar> parent;
+    std::vector<SeamCost<Masked>> lastRow;
+    relaxVerticalTiled<T, Masked>(energy, mask, bias, rowsPerStep, parent, lastRow);
+
+    // backtrack seam
+    std::vector<int> seam(rows);
+    int x = argminRow(lastRow.data(), cols);
+    for (int y = rows - 1; y >= 0; --y) {
+        seam[y] = x;
+        x += parent[static_cast<size_t>(y) * cols + x];
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Extracts up to count vertical seams from one DP pass (last cost row and parent array).
+ * End columns are tried in order of increasing cost and backtracked through the
+ * parent offsets; a path is accepted only if none of its pixels is claimed. Every
+ * accepted seam claims its pixels and their left/right neighbours, so the seams
+ * never touch and therefore never cross. The first seam is the optimal one; further
+ * seams are only taken from end columns cheaper than costLimit (the protect bias),
+ * so a batch never cuts through a protected region.
+ */
+template <typename Cost>
+static std::vector<std::vector<int>> extractDisjointSeams(const Cost* lastRow, const cv::Mat& parent, int count,
+                                                          Cost costLimit)
+{
+    const int rows = parent.rows;
+    const int cols = parent.cols;
+
+    // End columns ordered by cumulative cost (ties by column)
+    std::vector<int> order(cols);
+    for (int x = 0; x < cols; ++x)
+        order[x] = x;
+    std::sort(order.begin(), order.end(), [lastRow](int a, int b) {
+        return lastRow[a] < lastRow[b] || (lastRow[a] == lastRow[b] && a < b);
+    });
+
+    std::vector<uchar> claimed(static_cast<size_t>(rows) * cols, 0);
+    std::vector<std::vector<int>> seams;
+    std::vector<int> seam(rows);
+    for (int start : order)
+    {
+        if (static_cast<int>(seams.size()) == count || (!seams.empty() && lastRow[start] >= costLimit))
+            break;
+
+        // backtrack until the path runs into a claimed pixel
+        bool free = true;
+        int x = start;
+        for (int y = rows - 1; y >= 0; --y)
+        {
+            if (claimed[static_cast<size_t>(y) * cols + x])
+            {
+                free = false;
+                break;
+            }
+            seam[y] = x;
+            x += parent.at<schar>(y, x);
+        }
+        if (!free)
+            continue;
+
+        for (int y = 0; y < rows; ++y)
+            for (int c = std::max(seam[y] - 1, 0); c <= std::min(seam[y] + 1, cols - 1); ++c)
+                claimed[static_cast<size_t>(y) * cols + c] = 1;
+        seams.push_back(seam);
+    }
+
+    return seams;
+}
+
+/**
+ * @brief One DP pass for a batch of vertical seams (see extractDisjointSeams()).
+ * Runs the row-block DP when blockHeight > 0, else the strip-tiled DP when
+ * rowsPerStep > 0, else the full DP, whose cost and parent arrays go to the cache.
+ */
+template <typename T, bool Masked>
+static std::vector<std::vector<int>> findVerticalSeamsBatch(const cv::Mat& energy, const cv::Mat& mask, const float* bias,
+                                                            int blockHeight, int rowsPerStep, SeamDPCache& cache, int count)
+{
+    using Cost = SeamCost<Masked>;
+    const Cost costLimit = Masked ? static_cast<Cost>(bias[static_cast<int>(MaskLabel::Protect)])
+                                  : std::numeric_limits<Cost>::infinity();
+
+    if (blockHeight > 0 || rowsPerStep > 0)
+    {
+        std::vector<schar> parent;
+        std::vector<Cost> lastRow;
+        if (blockHeight > 0)
+            relaxVerticalBlocked<T, Masked>(energy, mask, bias, blockHeight, parent, lastRow);
+        else
+            relaxVerticalTiled<T, Masked>(energy, mask, bias, rowsPerStep, parent, lastRow);
+        return extractDisjointSeams(lastRow.data(), cv::Mat(energy.rows, energy.cols, CV_8S, parent.data()),
+                                    count, costLimit);
+    }
+
+    findVerticalSeamImpl<T, Masked>(energy, mask, bias, &cache);
+    return extractDisjointSeams(cache.cost.ptr<Cost>(energy.rows - 1), cache.parent, count, costLimit);
+}
+
+/**
+ * @brief Finds up to count vertical seams that do not touch each other.
+ * With the backward-energy DP the seams are extracted from a single DP pass
+ * (extractDisjointSeams()), run by the row-block or strip-tiled DP when one is
+ * selected. The banded DP only covers a corridor around one seam, so batches use
+ * the full DP instead; the forward-energy, low-memory and greedy finders return one
+ * seam per call.
+ *
+ * @param energy Pre-computed energy map of the image.
+ * @param count  Maximum number of seams.
+ * @return Seams as vectors of x-coordinates (at least one).
+ */
+std::vector<std::vector<int>> SeamCarver::findVerticalSeams(const cv::Mat& energy, int count)
+{
+    if (count > 1 && seamSearch == SeamSearch::DP && !lowMemoryDP && energy.rows > 0 && energy.cols > 0)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // one DP pass for the whole batch
+        const bool masked = !mask.empty();
+        dpCache.valid = false;
+        std::vector<std::vector<int>> seams;
+        if (energy.depth() == CV_16U)
+            seams = masked ? findVerticalSeamsBatch<ushort, true>(energy, mask, maskBias, dpBlockHeight, dpRowsPerStep, dpCache, count)
+                           : findVerticalSeamsBatch<ushort, false>(energy, mask, maskBias, dpBlockHeight, dpRowsPerStep, dpCache, count);
+        else
+            seams = masked ? findVerticalSeamsBatch<float, true>(energy, mask, maskBias, dpBlockHeight, dpRowsPerStep, dpCache, count)
+                           : findVerticalSeamsBatch<float, false>(energy, mask, maskBias, dpBlockHeight, dpRowsPerStep, dpCache, count);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end - start;
+        (transposed ? total_horizontal_seam_time : total_vertical_seam_time) += duration.count();
+        (transposed ? horizontal_seam_calls : vertical_seam_calls)++;
+
+        return seams;
+    }
+    return std::vector<std::vector<int>>(1, findVerticalSeam(energy));
+}
+
+/**
+ * @brief Finds a vertical seam of minimum energy.
+ * A vertical seam is one pixel per row, connected from top to bottom.
+ *
+ * @param energy Pre-computed energy map of the image.
+ * @return Vector of x-coordinates for each row indicating the seam position.
+ */
+std::vector<int> SeamCarver::findVerticalSeam(const cv::Mat& energy)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> seam = (this->*verticalSeamFinder)(energy);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+    // seams of the transposed image are horizontal seams of the original
+    (transposed ? total_horizontal_seam_time : total_vertical_seam_time) += duration.count();
+    (transposed ? horizontal_seam_calls : vertical_seam_calls)++;
+
+    return seam;
+}
+
+/**
+ * @brief Vertical seam finder of the DPSeams strategy: backward-energy DP, run as the
+ * low-memory, banded, row-block, strip-tiled or carried (cone) DP depending on the options.
+ */
+std::vector<int> SeamCarver::findVerticalSeamDP(const cv::Mat& energy)
+{
+    std::vector<int> seam;
+    const bool masked = !mask.empty();
+    if (lowMemoryDP)
+    {
+        dpCache.valid = false;
+        seam = masked ? findVerticalSeamCheckpointed<true>(energy, mask, maskBias)
+                      : findVerticalSeamCheckpointed<false>(energy, mask, maskBias);
+    }
+    else if (dpBand > 0 && maskRemoveCount == 0 && energy.rows > 0 && predictedSeam.size() == static_cast<size_t>(energy.rows))
+    {
+        // corridor around the previous seam instead of the carried full DP (an object
+        // to remove may lie outside any corridor, so object removal keeps the full DP)
+        dpCache.valid = false;
+        if (energy.depth() == CV_16U)
+            seam = masked ? findVerticalSeamBanded<ushort, true>(energy, mask, maskBias, predictedSeam, dpBand)
+                          : findVerticalSeamBanded<ushort, false>(energy, mask, maskBias, predictedSeam, dpBand);
+        else
+            seam = masked ? findVerticalSeamBanded<float, true>(energy, mask, maskBias, predictedSeam, dpBand)
+                          : findVerticalSeamBanded<float, false>(energy, mask, maskBias, predictedSeam, dpBand);
+    }
+    else if (dpBlockHeight > 0 && energy.rows > 0 && energy.cols > 0)
+    {
+        // row-block (min, +) DP across threads instead of the carried sequential DP
+        dpCache.valid = false;
+        if (energy.depth() == CV_16U)
+            seam = masked ? findVerticalSeamBlocked<ushort, true>(energy, mask, maskBias, dpBlockHeight)
+                          : findVerticalSeamBlocked<ushort, false>(energy, mask, maskBias, dpBlockHeight);
+        else
+            seam = masked ? findVerticalSeamBlocked<float, true>(energy, mask, maskBias, dpBlockHeight)
+                          : findVerticalSeamBlocked<float, false>(energy, mask, maskBias, dpBlockHeight);
+    }
+    else if (dpRowsPerStep > 0 && energy.rows > 0 && energy.cols > 0)
+    {
+        // column strips with trapezoid tiles across threads instead of the carried sequential DP
+        dpCache.valid = false;
+        if (energy.depth() == CV_16U)
+            seam = masked ? findVerticalSeamTiled<ushort, true>(energy, mask, maskBias, dpRowsPerStep)
+                          : findVerticalSeamTiled<ushort, false>(energy, mask, maskBias, dpRowsPerStep);
+        else
+            seam = masked ? findVerticalSeamTiled<float, true>(energy, mask, maskBias, dpRowsPerStep)
+                          : findVerticalSeamTiled<float, false>(energy, mask, maskBias, dpRowsPerStep);
+    }
+    else
+    {
+        // the DP is carried to the next seam while the energy map is maintained incrementally
+        SeamDPCache* cache = (incrementalEnergy && energyValid) ? &dpCache : nullptr;
+        if (energy.depth() == CV_16U)
+            seam = masked ? findVerticalSeamImpl<ushort, true>(energy, mask, maskBias, cache)
+                          : findVerticalSeamImpl<ushort, false>(energy, mask, maskBias, cache);
+        else
+            seam = masked ? findVerticalSeamImpl<float, true>(energy, mask, maskBias, cache)
+                          : findVerticalSeamImpl<float, false>(energy, mask, maskBias, cache);
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Vertical seam finder of the ForwardDPSeams strategy.
+ */
+std::vector<int> SeamCarver::findVerticalSeamForwardDP(const cv::Mat&)
+{
+    dpCache.valid = false;
+    return mask.empty() ? findVerticalSeamForward<false>(gray, mask, maskBias)
+                        : findVerticalSeamForward<true>(gray, mask, maskBias);
+}
+
+/**
+ * @brief Greedy seam walk on lazily evaluated costs, shared by both orientations.
+ * Along a seam of length `length` over `width` positions, the start is the cheapest
+ * position of line 0 and every following line takes the cheapest of the three
+ * positions next to the current one (ties keep the centre, then the lower position),
+ * like the map-based greedy finders. pixel(line, pos) maps to image coordinates and
+ * cost(pixels, n, out) evaluates n pixels, so only W + 3 * H pixels are evaluated.
+ */
+template <class PixelFn, class CostFn>
+static std::vector<int> findSeamGreedyLazy(int length, int width, PixelFn pixel, CostFn cost)
+{
+    std::vector<int> seam(length);
+    if (length == 0 || width == 0)
+        return seam;
+
+    // Start at the cheapest position of the first line
+    std::vector<cv::Point> first(width);
+    std::vector<float> firstCost(width);
+    for (int p = 0; p < width; ++p)
+        first[p] = pixel(0, p);
+    cost(first.data(), width, firstCost.data());
+    int pos = static_cast<int>(std::min_element(firstCost.begin(), firstCost.end()) - firstCost.begin());
+    seam[0] = pos;
+
+    // Probe the centre, lower and upper neighbour of every following line
+    for (int line = 1; line < length; ++line)
+    {
+        const int candidates[3] = { pos, std::max(pos - 1, 0), std::min(pos + 1, width - 1) };
+        const cv::Point probe[3] = { pixel(line, candidates[0]), pixel(line, candidates[1]), pixel(line, candidates[2]) };
+        float probeCost[3];
+        cost(probe, 3, probeCost);
+
+        int best = 0;
+        if (candidates[1] < pos && probeCost[1] < probeCost[best])
+            best = 1;
+        if (candidates[2] > pos && probeCost[2] < probeCost[best])
+            best = 2;
+
+        pos = candidates[best];
+        seam[line] = pos;
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Copies one line of seam costs into a cost line: energy plus mask bias.
+ *
+ * @param e        First energy value of the line.
+ * @param step     Element stride between consecutive positions of the line.
+ * @param m        First MaskLabel of the line, or nullptr without a mask.
+ * @param maskStep Element stride of the mask line.
+ * @param bias     Additive cost per MaskLabel.
+ * @param len      Line length.
+ * @param out      Receives the len costs.
+ */
+template <typename T, typename Cost>
+static void readCostLine(const T* e, size_t step, const uchar* m, size_t maskStep, const float* bias, int len, Cost* out)
+{
+    for (int i = 0; i < len; ++i)
+        out[i] = static_cast<Cost>(e[i * step]) + (m ? static_cast<Cost>(bias[m[i * maskStep]]) : Cost(0));
+}
+
+/**
+ * @brief Advances n independent greedy walks through float cost lines (SimdKernels::greedyWalks).
+ */
+static inline void advanceGreedyWalks(const float* const* lines, int count, int* pos, float* total, int n)
+{
+    simdKernels().greedyWalks(lines, count, pos, total, n);
+}
+
+/**
+ * @brief Advances n independent greedy walks through the double cost lines of a masked
+ * search, one walk at a time with the rules of SimdKernels::greedyWalks (ties keep the
+ * centre, then the left neighbour).
+ */
+static inline void advanceGreedyWalks(const double* const* lines, int count, int* pos, double* total, int n)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        int p = pos[i];
+        double sum = total[i];
+        for (int k = 1; k < count; ++k)
+        {
+            const double* line = lines[k];
+            int bestP = p;
+            if (line[p - 1] < line[bestP])
+                bestP = p - 1;
+            if (line[p + 1] < line[bestP])
+                bestP = p + 1;
+            p = bestP;
+            sum += line[p];
+        }
+        pos[i] = p;
+        total[i] = sum;
+    }
+}
+
+/**
+ * @brief Reads the seam cost (energy plus mask bias) of n pixels from an energy map.
+ */
+template <typename T>
+static void readMapCost(const cv::Mat& energy, const cv::Mat& mask, const float* bias, const cv::Point* pixels, int n, float* cost)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        cost[i] = static_cast<float>(energy.at<T>(pixels[i]));
+        if (!mask.empty())
+            cost[i] += bias[mask.at<uchar>(pixels[i])];
+    }
+}
+
+/**
+ * @brief Multi-start greedy seam: a greedy walk from every position of line 0.
+ *
+ * The costs are first copied into padded SeamCost lines (+inf at -1 and len), in
+ * parallel over lines. The walks are then advanced on chunks of start positions spread
+ * over the threads; no walk depends on another, so the chunks never synchronise. Float
+ * lines run the SimdKernels::greedyWalks kernel, one vector of walks per step; with a
+ * mask the lines and totals are double (the bias would swamp float totals) and each
+ * walk runs scalar. Only totals are kept: the cheapest walk is walked again to record
+ * its path.
+ *
+ * @param length   Number of lines (seam length).
+ * @param len      Positions per line.
+ * @param fillLine fillLine(k, out) writes the len costs of line k (out is a SeamCost<Masked>*).
+ * @return Position of the seam on every line.
+ */
+template <bool Masked, class LineFn>
+static std::vector<int> findSeamMultiStart(int length, int len, LineFn fillLine)
+{
+    using Cost = SeamCost<Masked>;
+    constexpr Cost INF = std::numeric_limits<Cost>::infinity();
+    constexpr int WALK_CHUNK = 256; // walks per parallel task
+
+    std::vector<int> seam(length);
+    if (length == 0 || len == 0)
+        return seam;
+
+    const size_t stride = static_cast<size_t>(len) + 2;
+    std::vector<Cost> costs(stride * length);
+    std::vector<const Cost*> lines(length);
+    for (int k = 0; k < length; ++k)
+        lines[k] = &costs[k * stride + 1];
+
+    cv::parallel_for_(cv::Range(0, length), [&](const cv::Range& range) {
+        for (int k = range.start; k < range.end; ++k)
+        {
+            Cost* line = &costs[k * stride];
+            line[0] = INF;
+            line[len + 1] = INF;
+            fillLine(k, line + 1);
+        }
+    });
+
+    // One walk per start position
+    std::vector<int> pos(len);
+    std::vector<Cost> total(lines[0], lines[0] + len);
+    for (int p = 0; p < len; ++p)
+        pos[p] = p;
+
+    const int chunks = (len + WALK_CHUNK - 1) / WALK_CHUNK;
+    cv::parallel_for_(cv::Range(0, chunks), [&](const cv::Range& range) {
+        for (int c = range.start; c < range.end; ++c)
+        {
+            const int first = c * WALK_CHUNK;
+            advanceGreedyWalks(lines.data(), length, &pos[first], &total[first], std::min(WALK_CHUNK, len - first));
+        }
+    });
+
+    // Walk the cheapest start again to record its path (same rules as greedyWalks)
+    int p = static_cast<int>(std::min_element(total.begin(), total.end()) - total.begin());
+    seam[0] = p;
+    for (int k = 1; k < length; ++k)
+    {
+        const Cost* line = lines[k];
+        int bestP = p;
+        if (line[p - 1] < line[bestP])
+            bestP = p - 1;
+        if (line[p + 1] < line[bestP])
+            bestP = p + 1;
+        p = bestP;
+        seam[k] = p;
+    }
+
+    return seam;
+}
+
+/**
+ * @brief Beam-search seam: keeps the beamWidth cheapest partial seams per line.
+ *
+ * Line 0 keeps its beamWidth cheapest positions. On every following line each kept
+ * seam is extended to its three neighbours, only the cheapest seam reaching each
+ * position survives (as in the DP), and the beamWidth cheapest of those are kept
+ * (ties by position). Each distinct candidate pixel is evaluated once through cost,
+ * so a seam reads about W + 3 * beamWidth * H pixels. The kept seams are recorded per
+ * line and the cheapest complete seam is backtracked. Every line needs the beam of the
+ * line before it and a line holds at most 3 * beamWidth candidates, so the search runs
+ * scalar on the calling thread; findSeamMultiStart() is the SIMD, multithreaded tier.
+ *
+ * @param length    Number of lines (seam length).
+ * @param len       Positions per line.
+ * @param beamWidth Partial seams kept per line.
+ * @param pixel     pixel(line, pos) maps to image coordinates.
+ * @param cost      cost(pixels, n, out) evaluates n pixels.
+ * @return Position of the seam on every line.
+ */
+template <class PixelFn, class CostFn>
+static std::vector<int> findSeamBeam(int length, int len, int beamWidth, PixelFn pixel, CostFn cost)
+{
+    struct PartialSeam {
+        double total; // Cost of the partial seam up to and including this line.
+        int pos;     // Position on this line.
+        int from;    // Index of the partial seam it extends on the previous line.
+    };
+    auto cheaper = [](const PartialSeam& a, const PartialSeam& b) {
+        return a.total < b.total || (a.total == b.total && a.pos < b.pos);
+    };
+
+    std::vector<int> seam(length);
+    if (length == 0 || len == 0)
+        return seam;
+    const int width = std::min(beamWidth, len);
+
+    // Line 0: the cheapest positions
+    std::vector<cv::Point> pixels(len);
+    std::vector<float> pixelCost(len);
+    for (int p = 0; p < len; ++p)
+        pixels[p] = pixel(0, p);
+    cost(pixels.data(), len, pixelCost.data());
+
+    std::vector<PartialSeam> beam(len);
+    for (int p = 0; p < len; ++p)
+        beam[p] = { pixelCost[p], p, -1 };
+    std::partial_sort(beam.begin(), beam.begin() + width, beam.end(), cheaper);
+    beam.resize(width);
+
+    // history[k] holds the partial seams kept on line k
+    std::vector<std::vector<PartialSeam>> history(length);
+    history[0] = beam;
+
+    std::vector<PartialSeam> candidates;
+    for (int k = 1; k < length; ++k)
+    {
+        // Extend every kept seam to its neighbours, in position order
+        candidates.clear();
+        for (int b = 0; b < static_cast<int>(beam.size()); ++b)
+            for (int d = -1; d <= 1; ++d)
+            {
+                const int q = beam[b].pos + d;
+                if (q >= 0 && q < len)
+                    candidates.push_back({ beam[b].total, q, b });
+            }
+        std::sort(candidates.begin(), candidates.end(), [](const PartialSeam& a, const PartialSeam& b) {
+            return a.pos < b.pos || (a.pos == b.pos && (a.total < b.total || (a.total == b.total && a.from < b.from)));
+        });
+
+        // The cheapest seam reaching each position survives
+        candidates.erase(std::unique(candidates.begin(), candidates.end(),
+            [](const PartialSeam& a, const PartialSeam& b) { return a.pos == b.pos; }), candidates.end());
+
+        const int n = static_cast<int>(candidates.size());
+        pixels.resize(n);
+        pixelCost.resize(n);
+        for (int i = 0; i < n; ++i)
+            pixels[i] = pixel(k, candidates[i].pos);
+        cost(pixels.data(), n, pixelCost.data());
+        for (int i = 0; i < n; ++i)
+            candidates[i].total += pixelCost[i];
+
+        const int keep = std::min(width, n);
+        std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), cheaper);
+        beam.assign(candidates.begin(), candidates.begin() + keep);
+        history[k] = beam;
     }
-#endif // USE_DP
 
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration = end - start;
-    total_vertical_seam_time += duration.count();
-    vertical_seam_calls++;
+    // The kept seams are sorted, so entry 0 of the last line is the cheapest
+    int b = 0;
+    for (int k = length - 1; k >= 0; --k)
+    {
+        seam[k] = history[k][b].pos;
+        b = history[k][b].from;
+    }
 
     return seam;
 }
 
 /**
- * @brief Finds a horizontal seam of minimum energy.
- * A horizontal seam is one pixel per column, connected left to right.
- *
- * @param energy Pre-computed energy map.
- * @return Vector of y-coordinates for each column indicating the seam position.
+ * @brief Vertical seam finder of the GreedySeams strategy.
  */
-std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
+std::vector<int> SeamCarver::findVerticalSeamGreedy(const cv::Mat& energy)
 {
-    auto start = std::chrono::high_resolution_clock::now();
+    const bool masked = !mask.empty();
+    if (energy.depth() == CV_16U)
+        return masked ? findVerticalSeamGreedyImpl<ushort, true>(energy, mask, maskBias)
+                      : findVerticalSeamGreedyImpl<ushort, false>(energy, mask, maskBias);
+    return masked ? findVerticalSeamGreedyImpl<float, true>(energy, mask, maskBias)
+                  : findVerticalSeamGreedyImpl<float, false>(energy, mask, maskBias);
+}
+
+/**
+ * @brief Vertical seam finder of the GreedySeams strategy with lazy energy (no map).
+ */
+std::vector<int> SeamCarver::findVerticalSeamGreedyLazy(const cv::Mat&)
+{
+    return findSeamGreedyLazy(image.rows, image.cols,
+        [](int y, int x) { return cv::Point(x, y); },
+        [this](const cv::Point* pixels, int n, float* cost) { probeSeamCost(pixels, n, cost); });
+}
+
+/**
+ * @brief Vertical seam finder of the GreedySeams strategy with walks from every column.
+ */
+std::vector<int> SeamCarver::findVerticalSeamMultiStart(const cv::Mat& energy)
+{
+    const bool masked = !mask.empty();
+    auto fillLine = [&](int y, auto* out) {
+        const uchar* m = masked ? mask.ptr<uchar>(y) : nullptr;
+        if (energy.depth() == CV_16U)
+            readCostLine(energy.ptr<ushort>(y), 1, m, 1, maskBias, energy.cols, out);
+        else
+            readCostLine(energy.ptr<float>(y), 1, m, 1, maskBias, energy.cols, out);
+    };
+    return masked ? findSeamMultiStart<true>(energy.rows, energy.cols, fillLine)
+                  : findSeamMultiStart<false>(energy.rows, energy.cols, fillLine);
+}
+
+/**
+ * @brief Vertical seam finder of the GreedySeams strategy with a beam of partial seams.
+ */
+std::vector<int> SeamCarver::findVerticalSeamBeam(const cv::Mat& energy)
+{
+    auto pixel = [](int y, int x) { return cv::Point(x, y); };
+    if (lazyEnergy)
+        return findSeamBeam(image.rows, image.cols, greedyBeam, pixel,
+            [this](const cv::Point* pixels, int n, float* cost) { probeSeamCost(pixels, n, cost); });
+
+    const auto readCost = (energy.depth() == CV_16U) ? &readMapCost<ushort> : &readMapCost<float>;
+    return findSeamBeam(energy.rows, energy.cols, greedyBeam, pixel,
+        [&](const cv::Point* pixels, int n, float* cost) { readCost(energy, mask, maskBias, pixels, n, cost); });
+}
 
-#ifdef USE_DP
+/**
+ * @brief Implementation of SeamCarver::findHorizontalSeam for an energy map of element type T
+ * (float for CV_32F maps, ushort for CV_16U maps). Costs are accumulated in SeamCost.
+ * When Masked, bias[mask(y, x)] is added to every energy read.
+ */
+template <typename T, bool Masked>
+static std::vector<int> findHorizontalSeamImpl(const cv::Mat& energy, const cv::Mat& mask, const float* bias)
+{
     // -------------------- DYNAMIC PROGRAMMING VERSION --------------------
     const int rows = energy.rows;
     const int cols = energy.cols;
@@ -298,7 +2138,7 @@ std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
     if (rows == 0 || cols == 0)
         return std::vector<int>();
 
-    if (cols == 1) {
+    if (cols == 1 && !Masked) {
         double minVal;
         cv::Point minLoc;
         cv::minMaxLoc(energy.col(0), &minVal, nullptr, &minLoc, nullptr);
@@ -306,23 +2146,26 @@ std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
     }
 
     const int size = rows * cols;
+    using Cost = SeamCost<Masked>;
 
-    std::vector<float> dp(size);
-    std::vector<int> parent(size, -1);
+    std::vector<Cost> dp(size);
+    std::vector<schar> parent(size, 0); // parent offset -1 / 0 / +1
 
     //Lambda to do 1D array instead of vector
     auto idx = [cols](int r, int c) { return r * cols + c; };
 
     for (int y = 0; y < rows; ++y) {
-        const float* eRow = energy.ptr<float>(y);
+        const T* eRow = energy.ptr<T>(y);
         dp[idx(y, 0)] = eRow[0];
+        if (Masked)
+            dp[idx(y, 0)] += bias[mask.at<uchar>(y, 0)];
     }
 
     for (int x = 1; x < cols; ++x) {
         for (int y = 0; y < rows; ++y) {
-            const float* eRow = energy.ptr<float>(y);
+            const T* eRow = energy.ptr<T>(y);
 
-            float bestCost = dp[idx(y, x - 1)];
+            Cost bestCost = dp[idx(y, x - 1)];
             int   bestY    = y;
 
             if (y > 0 && dp[idx(y - 1, x - 1)] < bestCost) {
@@ -334,16 +2177,20 @@ std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
                 bestY    = y + 1;
             }
 
-            dp[idx(y, x)]      = eRow[x] + bestCost;
-            parent[idx(y, x)]  = bestY;
+            Cost cost = eRow[x];
+            if (Masked)
+                cost += bias[mask.at<uchar>(y, x)];
+
+            dp[idx(y, x)]      = cost + bestCost;
+            parent[idx(y, x)]  = static_cast<schar>(bestY - y);
         }
     }
 
     // find minimum in last column
-    float minCost = dp[idx(0, cols - 1)];
+    Cost minCost = dp[idx(0, cols - 1)];
     int minIndex  = 0;
     for (int y = 1; y < rows; ++y) {
-        float v = dp[idx(y, cols - 1)];
+        Cost v = dp[idx(y, cols - 1)];
         if (v < minCost) {
             minCost = v;
             minIndex = y;
@@ -355,40 +2202,81 @@ std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
     int y = minIndex;
     for (int x = cols - 1; x >= 0; --x) {
         seam[x] = y;
-        int p = parent[idx(y, x)];
-        y = p;
+        y += parent[idx(y, x)];
     }
-#else
+
+    return seam;
+}
+
+/**
+ * @brief Greedy horizontal seam for an energy map of element type T: starts at the
+ * cheapest pixel of the first column and steps to the cheapest of the three pixels to the right.
+ * When Masked, bias[mask(y, x)] is added to every energy read.
+ */
+template <typename T, bool Masked>
+static std::vector<int> findHorizontalSeamGreedyImpl(const cv::Mat& energy, const cv::Mat& mask, const float* bias)
+{
     // -------------------- GREEDY VERSION --------------------
     const int rows = energy.rows;
     const int cols = energy.cols;
 
     std::vector<int> seam(cols);
 
+    //Lambda to read the (mask-biased) energy of a pixel
+    auto cost = [&](int r, int c) {
+        float e = energy.at<T>(r, c);
+        if (Masked)
+            e += bias[mask.at<uchar>(r, c)];
+        return e;
+    };
+
     // Start at min value in first column
-    double minVal;
-    cv::Point minLoc;
-    cv::minMaxLoc(energy.col(0), &minVal, nullptr, &minLoc, nullptr);
-    int y = minLoc.y;
+    int y = 0;
+    if (Masked) {
+        for (int r = 1; r < rows; ++r)
+            if (cost(r, 0) < cost(y, 0))
+                y = r;
+    }
+    else {
+        double minVal;
+        cv::Point minLoc;
+        cv::minMaxLoc(energy.col(0), &minVal, nullptr, &minLoc, nullptr);
+        y = minLoc.y;
+    }
     seam[0] = y;
 
     for (int x = 1; x < cols; ++x) {
         int bestY = y;
-        float bestVal = energy.at<float>(y, x);
+        float bestVal = cost(y, x);
 
-        if (y > 0 && energy.at<float>(y - 1, x) < bestVal) {
-            bestVal = energy.at<float>(y - 1, x);
+        if (y > 0 && cost(y - 1, x) < bestVal) {
+            bestVal = cost(y - 1, x);
             bestY = y - 1;
         }
-        if (y + 1 < rows && energy.at<float>(y + 1, x) < bestVal) {
-            bestVal = energy.at<float>(y + 1, x);
+        if (y + 1 < rows && cost(y + 1, x) < bestVal) {
+            bestVal = cost(y + 1, x);
             bestY = y + 1;
         }
 
         y = bestY;
         seam[x] = y;
     }
-#endif // USE_DP
+
+    return seam;
+}
+
+/**
+ * @brief Finds a horizontal seam of minimum energy.
+ * A horizontal seam is one pixel per column, connected left to right.
+ *
+ * @param energy Pre-computed energy map.
+ * @return Vector of y-coordinates for each column indicating the seam position.
+ */
+std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> seam = (this->*horizontalSeamFinder)(energy);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end - start;
@@ -398,6 +2286,123 @@ std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
     return seam;
 }
 
+/**
+ * @brief Horizontal seam finder of the DPSeams strategy (full or low-memory DP).
+ */
+std::vector<int> SeamCarver::findHorizontalSeamDP(const cv::Mat& energy)
+{
+    const bool masked = !mask.empty();
+    if (lowMemoryDP)
+        return masked ? findHorizontalSeamCheckpointed<true>(energy, mask, maskBias)
+                      : findHorizontalSeamCheckpointed<false>(energy, mask, maskBias);
+    if (energy.depth() == CV_16U)
+        return masked ? findHorizontalSeamImpl<ushort, true>(energy, mask, maskBias)
+                      : findHorizontalSeamImpl<ushort, false>(energy, mask, maskBias);
+    return masked ? findHorizontalSeamImpl<float, true>(energy, mask, maskBias)
+                  : findHorizontalSeamImpl<float, false>(energy, mask, maskBias);
+}
+
+/**
+ * @brief Horizontal seam finder of the ForwardDPSeams strategy.
+ */
+std::vector<int> SeamCarver::findHorizontalSeamForwardDP(const cv::Mat&)
+{
+    return mask.empty() ? findHorizontalSeamForward<false>(gray, mask, maskBias)
+                        : findHorizontalSeamForward<true>(gray, mask, maskBias);
+}
+
+/**
+ * @brief Horizontal seam finder of the GreedySeams strategy.
+ */
+std::vector<int> SeamCarver::findHorizontalSeamGreedy(const cv::Mat& energy)
+{
+    const bool masked = !mask.empty();
+    if (energy.depth() == CV_16U)
+        return masked ? findHorizontalSeamGreedyImpl<ushort, true>(energy, mask, maskBias)
+                      : findHorizontalSeamGreedyImpl<ushort, false>(energy, mask, maskBias);
+    return masked ? findHorizontalSeamGreedyImpl<float, true>(energy, mask, maskBias)
+                  : findHorizontalSeamGreedyImpl<float, false>(energy, mask, maskBias);
+}
+
+/**
+ * @brief Horizontal seam finder of the GreedySeams strategy with lazy energy (no map).
+ */
+std::vector<int> SeamCarver::findHorizontalSeamGreedyLazy(const cv::Mat&)
+{
+    return findSeamGreedyLazy(image.cols, image.rows,
+        [](int x, int y) { return cv::Point(x, y); },
+        [this](const cv::Point* pixels, int n, float* cost) { probeSeamCost(pixels, n, cost); });
+}
+
+/**
+ * @brief Horizontal seam finder of the GreedySeams strategy with walks from every row.
+ */
+std::vector<int> SeamCarver::findHorizontalSeamMultiStart(const cv::Mat& energy)
+{
+    const bool masked = !mask.empty();
+    // line x is column x of the map
+    auto fillLine = [&](int x, auto* out) {
+        const uchar* m = masked ? mask.ptr<uchar>(0) + x : nullptr;
+        if (energy.depth() == CV_16U)
+            readCostLine(energy.ptr<ushort>(0) + x, energy.step1(), m, mask.step1(), maskBias, energy.rows, out);
+        else
+            readCostLine(energy.ptr<float>(0) + x, energy.step1(), m, mask.step1(), maskBias, energy.rows, out);
+    };
+    return masked ? findSeamMultiStart<true>(energy.cols, energy.rows, fillLine)
+                  : findSeamMultiStart<false>(energy.cols, energy.rows, fillLine);
+}
+
+/**
+ * @brief Horizontal seam finder of the GreedySeams strategy with a beam of partial seams.
+ */
+std::vector<int> SeamCarver::findHorizontalSeamBeam(const cv::Mat& energy)
+{
+    auto pixel = [](int x, int y) { return cv::Point(x, y); };
+    if (lazyEnergy)
+        return findSeamBeam(image.cols, image.rows, greedyBeam, pixel,
+            [this](const cv::Point* pixels, int n, float* cost) { probeSeamCost(pixels, n, cost); });
+
+    const auto readCost = (energy.depth() == CV_16U) ? &readMapCost<ushort> : &readMapCost<float>;
+    return findSeamBeam(energy.cols, energy.rows, greedyBeam, pixel,
+        [&](const cv::Point* pixels, int n, float* cost) { readCost(energy, mask, maskBias, pixels, n, cost); });
+}
+
+/**
+ * @brief Points the seam finders at the specialised finders of a strategy.
+ */
+void SeamCarver::selectSeamFinders(SeamSearch search)
+{
+    seamSearch = search;
+    switch (search)
+    {
+    case SeamSearch::ForwardDP:
+        verticalSeamFinder = &SeamCarver::findVerticalSeamForwardDP;
+        horizontalSeamFinder = &SeamCarver::findHorizontalSeamForwardDP;
+        break;
+    case SeamSearch::Greedy:
+        if (greedyAllStarts)
+        {
+            verticalSeamFinder = &SeamCarver::findVerticalSeamMultiStart;
+            horizontalSeamFinder = &SeamCarver::findHorizontalSeamMultiStart;
+        }
+        else if (greedyBeam > 1)
+        {
+            verticalSeamFinder = &SeamCarver::findVerticalSeamBeam;
+            horizontalSeamFinder = &SeamCarver::findHorizontalSeamBeam;
+        }
+        else
+        {
+            verticalSeamFinder = lazyEnergy ? &SeamCarver::findVerticalSeamGreedyLazy : &SeamCarver::findVerticalSeamGreedy;
+            horizontalSeamFinder = lazyEnergy ? &SeamCarver::findHorizontalSeamGreedyLazy : &SeamCarver::findHorizontalSeamGreedy;
+        }
+        break;
+    default:
+        verticalSeamFinder = &SeamCarver::findVerticalSeamDP;
+        horizontalSeamFinder = &SeamCarver::findHorizontalSeamDP;
+        break;
+    }
+}
+
 /**
  * @brief Removes a vertical seam from the image.
  * Given a seam specifying one column index per row, this function shifts the
@@ -406,35 +2411,135 @@ std::vector<int> SeamCarver::findHorizontalSeam(const cv::Mat& energy)
  * @param seam Vector of x-coordinates specifying the seam path.
  */
 void SeamCarver::removeVerticalSeam(const std::vector<int>& seam)
+{
+    removeVerticalSeams(std::vector<std::vector<int>>(1, seam));
+}
+
+/**
+ * @brief Removes several non-overlapping vertical seams in one compaction.
+ * The energy is refreshed around every seam at its position in the compacted
+ * image (the seam column minus the number of seams left of it in that row).
+ *
+ * @param seams Seams to remove, each a vector of x-coordinates.
+ */
+void SeamCarver::removeVerticalSeams(const std::vector<std::vector<int>>& seams)
 {
     auto start = std::chrono::high_resolution_clock::now();
 
-    const int rows = image.rows;
-    const int cols = image.cols;
+    checkSeams(seams, image.rows, image.cols);
 
-    // Create a new image with one less column
-    cv::Mat newImage(rows, cols - 1, image.type());
+    const int count = static_cast<int>(seams.size());
+    const int rows = image.rows;
 
-    // Remove the seam
-    for (int i = 0; i < rows; ++i)
+    // Position of the i-th seam from the left in every row of the compacted image
+    std::vector<std::vector<int>> compacted(count, std::vector<int>(rows));
+    std::vector<int> seamCols(count);
+    for (int y = 0; y < rows; ++y)
     {
-        int seamCol = seam[i];
+        for (int s = 0; s < count; ++s)
+            seamCols[s] = seams[s][y];
+        std::sort(seamCols.begin(), seamCols.end());
+        for (int s = 0; s < count; ++s)
+            compacted[s][y] = seamCols[s] - s;
+    }
 
-        // Copy all rows before the seam
-        if (seamCol > 0)
-            image(cv::Range(i, i + 1), cv::Range(0, seamCol)).copyTo(newImage(cv::Range(i, i + 1), cv::Range(0, seamCol)));
+    // Keep the persistent gray/energy layers, the saliency layer and the mask aligned with the image
+    std::vector<cv::Mat*> layers = { &image };
+    if (energyValid)
+    {
+        layers.push_back(&gray);
+        if (!grayOnly)
+            layers.push_back(&energy);
+    }
+    if (!saliency.empty())
+        layers.push_back(&saliency);
+    if (dpCache.valid && energyValid && count == 1)
+    {
+        layers.push_back(&dpCache.cost);
+        layers.push_back(&dpCache.parent);
+    }
+    else
+    {
+        dpCache.valid = false;
+    }
+    if (!mask.empty())
+    {
+        for (const std::vector<int>& seam : seams)
+            for (int y = 0; y < mask.rows; ++y)
+                if (mask.at<uchar>(y, seam[y]) == static_cast<uchar>(MaskLabel::Remove))
+                    maskRemoveCount--;
+        layers.push_back(&mask);
+    }
 
-        // Copy all rows after the seam
-        if (seamCol < cols - 1)
-            image(cv::Range(i, i + 1), cv::Range(seamCol + 1, cols)).copyTo(newImage(cv::Range(i, i + 1), cv::Range(seamCol, cols - 1)));
+    // The integral images are updated from the removed gray values below
+    std::vector<uchar> removedGray;
+    if (energyValid && !grayOnly && varianceRadius > 0 && count == 1)
+    {
+        removedGray.resize(rows);
+        for (int y = 0; y < rows; ++y)
+            removedGray[y] = gray.at<uchar>(y, seams[0][y]);
     }
 
-    image = newImage;
+    removeVerticalSeamsFromLayers(layers, seams);
+
+    // The leftmost removed seam predicts the next one for the banded DP
+    predictedSeam = compacted[0];
+    for (int& x : predictedSeam)
+        x = std::min(x, image.cols - 1);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end - start;
-    total_vertical_remove_time += duration.count();
-    vertical_remove_calls++;
+    (transposed ? total_horizontal_remove_time : total_vertical_remove_time) += duration.count();
+    (transposed ? horizontal_remove_calls : vertical_remove_calls)++;
+
+    // the energy band is refreshed only where a map is kept
+    if (energyValid && !grayOnly)
+    {
+        auto update_start = std::chrono::high_resolution_clock::now();
+
+        // A batch of seams changes every integral column right of the first one,
+        // so the integrals are rebuilt once instead of being patched per seam
+        if (varianceRadius > 0 && count == 1)
+        {
+            removeVerticalSeamFromIntegral(graySum, gray, seams[0], removedGray, false);
+            removeVerticalSeamFromIntegral(graySqSum, gray, seams[0], removedGray, true);
+        }
+        else if (varianceRadius > 0)
+        {
+            cv::integral(gray, graySum, graySqSum, CV_64F, CV_64F);
+        }
+
+        // Only pixels whose 3x3 neighbourhood contained a seam change energy:
+        // columns [seam-2, seam+1] in the compacted row. For the local-variance
+        // energy the band covers the seam positions of all rows in the window.
+        // For a single seam the bands are kept so the next DP only relaxes them
+        // and the cells below changed costs.
+        const int cols = energy.cols;
+        const int reach = std::max(varianceRadius, 1);
+        dpCache.energyBand.resize(rows);
+        for (const std::vector<int>& seam : compacted)
+        {
+            for (int y = 0; y < rows; ++y)
+            {
+                int sMin = seam[y];
+                int sMax = seam[y];
+                for (int k = std::max(y - varianceRadius, 0); k <= std::min(y + varianceRadius, rows - 1); ++k)
+                {
+                    sMin = std::min(sMin, seam[k]);
+                    sMax = std::max(sMax, seam[k]);
+                }
+                int x0 = std::max(sMin - reach - 1, 0);
+                int x1 = std::min(sMax + reach, cols - 1);
+                refreshEnergySpan(y, x0, x1);
+                dpCache.energyBand[y] = cv::Vec2i(x0, x1);
+            }
+        }
+
+        auto update_end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> update_duration = update_end - update_start;
+        total_energy_update_time += update_duration.count();
+        energy_update_calls++;
+    }
 }
 
 /**
@@ -445,35 +2550,235 @@ void SeamCarver::removeVerticalSeam(const std::vector<int>& seam)
  * @param seam Vector of y-coordinates specifying the seam path.
  */
 void SeamCarver::removeHorizontalSeam(const std::vector<int>& seam)
+{
+    removeHorizontalSeams(std::vector<std::vector<int>>(1, seam));
+}
+
+/**
+ * @brief Removes several non-overlapping horizontal seams in one compaction.
+ * The energy is refreshed around every seam at its position in the compacted
+ * image (the seam row minus the number of seams above it in that column).
+ *
+ * @param seams Seams to remove, each a vector of y-coordinates.
+ */
+void SeamCarver::removeHorizontalSeams(const std::vector<std::vector<int>>& seams)
 {
     auto start = std::chrono::high_resolution_clock::now();
 
-    const int rows = image.rows;
+    checkSeams(seams, image.cols, image.rows);
+
+    const int count = static_cast<int>(seams.size());
     const int cols = image.cols;
 
-    // Create a new image with one less row
-    cv::Mat newImage(rows - 1, cols, image.type());
+    // The cached vertical DP and the banded-DP prediction do not survive a horizontal seam
+    dpCache.valid = false;
+    predictedSeam.clear();
 
-    // Remove the seam
-    for (int i = 0; i < cols; ++i)
+    // Position of the i-th seam from the top in every column of the compacted image
+    std::vector<std::vector<int>> compacted(count, std::vector<int>(cols));
+    std::vector<int> seamRows(count);
+    for (int x = 0; x < cols; ++x)
     {
-        int seamRow = seam[i];
+        for (int s = 0; s < count; ++s)
+            seamRows[s] = seams[s][x];
+        std::sort(seamRows.begin(), seamRows.end());
+        for (int s = 0; s < count; ++s)
+            compacted[s][x] = seamRows[s] - s;
+    }
 
-        // Copy all rows before the seam
-        if (seamRow > 0)
-            image(cv::Range(0, seamRow), cv::Range(i, i + 1)).copyTo(newImage(cv::Range(0, seamRow), cv::Range(i, i + 1)));
+    // Keep the persistent gray/energy layers, the saliency layer and the mask aligned with the image
+    std::vector<cv::Mat*> layers = { &image };
+    if (energyValid)
+    {
+        layers.push_back(&gray);
+        if (!grayOnly)
+            layers.push_back(&energy);
+    }
+    if (!saliency.empty())
+        layers.push_back(&saliency);
+    if (!mask.empty())
+    {
+        for (const std::vector<int>& seam : seams)
+            for (int x = 0; x < mask.cols; ++x)
+                if (mask.at<uchar>(seam[x], x) == static_cast<uchar>(MaskLabel::Remove))
+                    maskRemoveCount--;
+        layers.push_back(&mask);
+    }
 
-        // Copy all rows after the seam
-        if (seamRow < rows - 1)
-            image(cv::Range(seamRow + 1, rows), cv::Range(i, i + 1)).copyTo(newImage(cv::Range(seamRow, rows - 1), cv::Range(i, i + 1)));
+    // The integral images are updated from the removed gray values below
+    std::vector<uchar> removedGray;
+    if (energyValid && !grayOnly && varianceRadius > 0 && count == 1)
+    {
+        removedGray.resize(cols);
+        for (int x = 0; x < cols; ++x)
+            removedGray[x] = gray.at<uchar>(seams[0][x], x);
     }
 
-    image = newImage;
+    removeHorizontalSeamsFromLayers(layers, seams);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end - start;
     total_horizontal_remove_time += duration.count();
     horizontal_remove_calls++;
+
+    // the energy band is refreshed only where a map is kept
+    if (energyValid && !grayOnly)
+    {
+        auto update_start = std::chrono::high_resolution_clock::now();
+
+        // A batch of seams changes every integral row below the first one,
+        // so the integrals are rebuilt once instead of being patched per seam
+        if (varianceRadius > 0 && count == 1)
+        {
+            removeHorizontalSeamFromIntegral(graySum, gray, seams[0], removedGray, false);
+            removeHorizontalSeamFromIntegral(graySqSum, gray, seams[0], removedGray, true);
+        }
+        else if (varianceRadius > 0)
+        {
+            cv::integral(gray, graySum, graySqSum, CV_64F, CV_64F);
+        }
+
+        // Only pixels whose 3x3 neighbourhood contained a seam change energy:
+        // rows [seam-2, seam+1] in the compacted column. For the local-variance
+        // energy the band covers the seam positions of all columns in the window.
+        // The band columns of all seams are bucketed by row, so each row is refreshed
+        // in runs of consecutive columns rather than pixel by pixel.
+        const int rows = energy.rows;
+        const int reach = std::max(varianceRadius, 1);
+        std::vector<cv::Vec2i> band(static_cast<size_t>(count) * cols); // rows [y0, y1] per seam and column
+        std::vector<int> rowStart(rows + 1, 0);
+        for (int s = 0; s < count; ++s)
+        {
+            const std::vector<int>& seam = compacted[s];
+            for (int x = 0; x < cols; ++x)
+            {
+                int sMin = seam[x];
+                int sMax = seam[x];
+                for (int k = std::max(x - varianceRadius, 0); k <= std::min(x + varianceRadius, cols - 1); ++k)
+                {
+                    sMin = std::min(sMin, seam[k]);
+                    sMax = std::max(sMax, seam[k]);
+                }
+                const cv::Vec2i span(std::max(sMin - reach - 1, 0), std::min(sMax + reach, rows - 1));
+                band[static_cast<size_t>(s) * cols + x] = span;
+                for (int y = span[0]; y <= span[1]; ++y)
+                    rowStart[y + 1]++;
+            }
+        }
+        for (int y = 0; y < rows; ++y)
+            rowStart[y + 1] += rowStart[y];
+
+        // Columns of every row, in increasing order per seam
+        std::vector<int> rowCols(rowStart[rows]);
+        std::vector<int> fill(rowStart.begin(), rowStart.end() - 1);
+        for (int s = 0; s < count; ++s)
+        {
+            for (int x = 0; x < cols; ++x)
+            {
+                const cv::Vec2i& span = band[static_cast<size_t>(s) * cols + x];
+                for (int y = span[0]; y <= span[1]; ++y)
+                    rowCols[fill[y]++] = x;
+            }
+        }
+
+        for (int y = 0; y < rows; ++y)
+        {
+            int* first = rowCols.data() + rowStart[y];
+            int* last = rowCols.data() + rowStart[y + 1];
+            if (count > 1)
+            {
+                std::sort(first, last);
+                last = std::unique(first, last);
+            }
+            while (first != last)
+            {
+                int* end = first + 1;
+                while (end != last && *end == *(end - 1) + 1)
+                    ++end;
+                refreshEnergySpan(y, *first, *(end - 1));
+                first = end;
+            }
+        }
+
+        auto update_end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> update_duration = update_end - update_start;
+        total_energy_update_time += update_duration.count();
+        energy_update_calls++;
+    }
+}
+
+/**
+ * @brief Attaches a protect/remove mask to the image.
+ *
+ * @param labels Mask of MaskLabel values, or an empty matrix to remove the mask.
+ */
+void SeamCarver::setMask(const cv::Mat& labels)
+{
+    maskRemoveCount = 0;
+    if (labels.empty())
+    {
+        mask.release();
+        return;
+    }
+
+    CV_Assert(labels.type() == CV_8UC1 && labels.size() == image.size());
+
+    mask = labels.clone();
+    for (int y = 0; y < mask.rows; ++y)
+    {
+        uchar* mRow = mask.ptr<uchar>(y);
+        for (int x = 0; x < mask.cols; ++x)
+        {
+            CV_Assert(mRow[x] <= static_cast<uchar>(MaskLabel::Remove));
+            if (mRow[x] == static_cast<uchar>(MaskLabel::Remove))
+                maskRemoveCount++;
+        }
+    }
+}
+
+/**
+ * @brief Sets the per-label mask bias for the current resize job.
+ */
+void SeamCarver::updateMaskBias()
+{
+    // Largest cost a single pixel contributes to a seam
+    // (lazy and forward-energy jobs build one map here and drop it)
+    double maxCost = 0.0;
+    cv::minMaxLoc((lazyEnergy || grayOnly) ? computeEnergyMap() : currentEnergyMap(), nullptr, &maxCost);
+    if (seamSearch == SeamSearch::ForwardDP)
+        maxCost = std::max(maxCost, 2.0 * 255.0); // C_L / C_R: two gray differences
+
+    const float bias = static_cast<float>(2.0 * (maxCost + 1.0) * std::max(image.rows, image.cols));
+    maskBias[static_cast<int>(MaskLabel::None)] = 0.f;
+    maskBias[static_cast<int>(MaskLabel::Protect)] = bias;
+    maskBias[static_cast<int>(MaskLabel::Remove)] = -bias;
+}
+
+/**
+ * @brief Transposes the image and the layers carried with it (mask, saliency).
+ * The energy map, the integrals and the DP state are rebuilt for the new orientation.
+ */
+void SeamCarver::transposeLayers()
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (cv::Mat* layer : { &image, &mask, &saliency })
+    {
+        if (layer->empty())
+            continue;
+        cv::Mat transposedLayer;
+        cv::transpose(*layer, transposedLayer);
+        *layer = transposedLayer;
+    }
+    transposed = !transposed;
+    energyValid = false;
+    dpCache.valid = false;
+    predictedSeam.clear();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+    total_transpose_time += duration.count();
+    transpose_calls++;
 }
 
 /**
@@ -487,6 +2792,11 @@ void SeamCarver::resize(int targetWidth, int targetHeight)
     // Reset timing at the start of each resize operation
     resetTiming();
 
+    // The persistent energy map (and the DP carried with it) is rebuilt once per job
+    energyValid = false;
+    dpCache.valid = false;
+    predictedSeam.clear();
+
     auto total_start = std::chrono::high_resolution_clock::now();
 
     if (targetWidth <= 0 || targetHeight <= 0)
@@ -506,11 +2816,49 @@ void SeamCarver::resize(int targetWidth, int targetHeight)
     std::cout << "Removing " << (image.cols - targetWidth) << " vertical and "
         << (image.rows - targetHeight) << " horizontal seams..." << std::endl;
 
+    // Saliency is computed once per job on a small proxy and then carried as a layer
+    if (saliencyWeight > 0.f)
+    {
+        auto saliency_start = std::chrono::high_resolution_clock::now();
+        computeSpectralResidualSaliency(image, saliency, saliencyBuffers);
+        std::chrono::duration<double> saliency_duration = std::chrono::high_resolution_clock::now() - saliency_start;
+        total_energy_time += saliency_duration.count();
+    }
+    else
+    {
+        saliency.release();
+    }
+
+    // Greedy seams with a 3x3 energy only evaluate the pixels they probe, so no map is kept
+    // (the multi-start search reads every pixel and uses the map)
+    lazyEnergy = seamSearch == SeamSearch::Greedy && lazyGreedyEnergy && varianceRadius == 0 && !greedyAllStarts;
+    energyProbe = (energyKernels.builtin && integerEnergy) ? &probeEnergyT<IntegerSobelEnergy> : energyKernels.probe;
+    // Forward-energy seams read gray only, so no backward energy map is kept either
+    grayOnly = seamSearch == SeamSearch::ForwardDP;
+    if (lazyEnergy || grayOnly)
+        energy.release();
+    selectSeamFinders(seamSearch);
+
+    // Object removal ends once the last MaskLabel::Remove pixel has been carved
+    const bool removingObject = maskRemoveCount > 0;
+    if (!mask.empty())
+        updateMaskBias();
+
+    // Size of the image in its original orientation (the working image may be transposed)
+    auto width = [this]() { return transposed ? image.rows : image.cols; };
+    auto height = [this]() { return transposed ? image.cols : image.rows; };
+
     int iteration = 0;
-    while (image.cols > targetWidth || image.rows > targetHeight)
+    while (width() > targetWidth || height() > targetHeight)
     {
-        int removeWidth = image.cols - targetWidth; //remaining vertical seams to remove
-        int removeHeight = image.rows - targetHeight; //remaining horizontal seams to remove
+        if (removingObject && maskRemoveCount == 0)
+        {
+            std::cout << "Masked object removed after " << iteration << " seams." << std::endl;
+            break;
+        }
+
+        int removeWidth = width() - targetWidth; //remaining vertical seams to remove
+        int removeHeight = height() - targetHeight; //remaining horizontal seams to remove
 
         //Check dimensions that require shrinking
         bool removeVert = false;
@@ -521,35 +2869,60 @@ void SeamCarver::resize(int targetWidth, int targetHeight)
         else
         {
             //choose the dimension with larger normalized remaining fraction
-            double fracW = static_cast<double>(removeWidth) / image.cols;
-            double fracH = static_cast<double>(removeHeight) / image.rows;
+            double fracW = static_cast<double>(removeWidth) / width();
+            double fracH = static_cast<double>(removeHeight) / height();
             removeVert = (fracW >= fracH);
         }
 
+        int removed = 1;
         if (removeVert && removeWidth > 0)
         {
-            cv::Mat energy = computeEnergyMap();
-            std::vector<int> seam = findVerticalSeam(energy);
+            if (transposed)
+                transposeLayers();
 
-            cv::Mat vis = image.clone();
-            drawSeamOnImage(vis, seam, true);
+            // Several disjoint seams per DP pass, one at a time while removing an object
+            int count = removingObject ? 1 : std::min(seamsPerPass, removeWidth);
+            std::vector<std::vector<int>> seams = findVerticalSeams(currentEnergyMap(), count);
 
 #ifndef VISUALISE
+            cv::Mat vis = image.clone();
+            for (const std::vector<int>& seam : seams)
+                drawSeamOnImage(vis, seam, true);
             cv::imshow("SeamCarving (Also Vertical Visualisation)", vis);
             cv::waitKey(1);
 #endif
 
-            removeVerticalSeam(seam);
+            removeVerticalSeams(seams);
+            removed = static_cast<int>(seams.size());
         }
-        else if (!removeVert && removeHeight > 0)
+        else if (!removeVert && removeHeight > 0 && transposeHorizontal)
         {
-            cv::Mat energy = computeEnergyMap();
-            std::vector<int> seam = findHorizontalSeam(energy);
+            // Horizontal seams are vertical seams of the transposed image, which is kept
+            // until the orientation switches again
+            if (!transposed)
+                transposeLayers();
 
+            int count = removingObject ? 1 : std::min(seamsPerPass, removeHeight);
+            std::vector<std::vector<int>> seams = findVerticalSeams(currentEnergyMap(), count);
+
+#ifndef VISUALISE
             cv::Mat vis = image.clone();
-            drawSeamOnImage(vis, seam, false);
+            for (const std::vector<int>& seam : seams)
+                drawSeamOnImage(vis, seam, true);
+            cv::transpose(vis, vis);
+            cv::imshow("Horizontal", vis);
+            cv::waitKey(1);
+#endif
+            removeVerticalSeams(seams);
+            removed = static_cast<int>(seams.size());
+        }
+        else if (!removeVert && removeHeight > 0)
+        {
+            std::vector<int> seam = findHorizontalSeam(currentEnergyMap());
 
 #ifndef VISUALISE
+            cv::Mat vis = image.clone();
+            drawSeamOnImage(vis, seam, false);
             cv::imshow("Horizontal", vis);
             cv::waitKey(1);
 #endif
@@ -560,18 +2933,22 @@ void SeamCarver::resize(int targetWidth, int targetHeight)
             break;
         }
 
-        iteration++;
+        int previous = iteration;
+        iteration += removed;
         //To display resizing progress
-        if (iteration % 10 == 0) {
+        if (iteration / 10 != previous / 10) {
             std::cout << "Progress: " << iteration << " seams removed. Current size: "
-                << image.cols << "x" << image.rows << std::endl;
+                << width() << "x" << height() << std::endl;
         }
 #ifndef VISUALISE
-        cv::imshow("SeamCarving (Also Vertical Visualisation)", image);
+        cv::imshow("SeamCarving (Also Vertical Visualisation)", transposed ? cv::Mat(image.t()) : image);
         cv::waitKey(1);
 #endif
     }
 
+    if (transposed)
+        transposeLayers();
+
     auto total_end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> total_duration = total_end - total_start;
 
@@ -1,8 +1,49 @@
 #pragma once
 #include "opencv2/opencv.hpp"
 #include <vector>
+#include "EnergyKernels.h"
+#include "MaskLabel.h"
+#include "SimdKernels.h"
 #define SOLUTION
-#define USE_DP // Use dynamic programming for seam finding by default, otherwise use greedy approach
+
+/**
+ * @brief Selects how SeamCarver computes a full energy map.
+ */
+enum class EnergyEngine {
+    OpenCV, // Separate cvtColor / Sobel / magnitude calls (reference path).
+    Fused,  // Single-pass SIMD kernel streaming rows through a 3-row ring buffer.
+    Parallel // Fused kernel run on horizontal stripes across threads (cv::parallel_for_).
+};
+
+/**
+ * @brief Seam search algorithms, selected through the seam strategy policies below.
+ */
+enum class SeamSearch {
+    DP,        // Dynamic programming on the energy map (globally minimum-energy seam).
+    ForwardDP, // Dynamic programming on forward energy (Rubinstein et al.).
+    Greedy     // Locally best next pixel per row/column (fast preview).
+};
+
+/**
+ * @brief Seam strategy policies for SeamCarver::setSeamStrategy<Strategy>() and
+ * SeamCarver::resize<Strategy>(). Each strategy has its own specialised seam finders,
+ * which are selected once per job, so the hot loops contain no strategy checks.
+ */
+struct DPSeams { static constexpr SeamSearch search = SeamSearch::DP; };
+struct ForwardDPSeams { static constexpr SeamSearch search = SeamSearch::ForwardDP; };
+struct GreedySeams { static constexpr SeamSearch search = SeamSearch::Greedy; };
+
+/**
+ * @brief DP state kept between vertical seams for the incremental (cone) DP update.
+ * After a seam is removed, cost and parent are compacted like the image and only
+ * the cells whose energy or upper neighbours changed are relaxed again.
+ */
+struct SeamDPCache {
+    cv::Mat cost;   // Cumulative seam cost (CV_32F, CV_64F while a mask is set).
+    cv::Mat parent; // CV_8S parent offsets (-1 / 0 / +1).
+    std::vector<cv::Vec2i> energyBand; // Per row, columns [x0, x1] whose energy was refreshed after the last seam.
+    bool valid = false; // True when cost/parent match the current energy map apart from energyBand.
+};
 
 /**
  * @class SeamCarver
@@ -11,18 +52,94 @@
  * This class provides functionality to reduce image width and/or height by
  * iteratively removing low-energy seams. The seams are determined using either:
  *   - Dynamic Programming (default), which finds the globally minimum-energy seam.
- *   - Greedy Algorithm (when USE_DP is disabled), which selects the locally best seam.
+ *   - Forward-energy Dynamic Programming, which minimises the gradient the seam inserts.
+ *   - Greedy Algorithm, which selects the locally best seam.
+ * The strategy is a policy type chosen per resize job (resize<GreedySeams>(w, h)).
  */
 class SeamCarver {
 private:
     cv::Mat image; // Internal image storage containing current working image.
+    cv::Mat gray;  // 8-bit luminance of the working image, compacted together with it.
+    cv::Mat energy; // Persistent energy map, compacted together with the image.
+    cv::Mat mask;   // Optional CV_8U MaskLabel layer, compacted together with the image.
+    cv::Mat graySum;   // CV_64F integral of gray (local-variance energy only).
+    cv::Mat graySqSum; // CV_64F integral of gray^2 (local-variance energy only).
+    cv::Mat saliency;  // CV_32F spectral-residual saliency, computed once per job and compacted with the image.
+    SaliencyBuffers saliencyBuffers; // DFT work buffers of the saliency, reused between jobs.
+
+    EnergyEngine energyEngine = EnergyEngine::OpenCV; // Kernel used for full energy maps.
+    EnergyKernelSet energyKernels = energyKernelsFor<SobelEnergy>(); // Energy function policy.
+    int varianceRadius = 0;        // Window radius of the local-variance energy (0 = off).
+    float saliencyWeight = 0.f;    // Weight of the saliency term blended into the energy (0 = off).
+    bool integerEnergy = false;    // Store energy as CV_16U Sobel L1 instead of CV_32F Sobel L2.
+    bool lowMemoryDP = false;      // DP keeps two rows plus sqrt(H) checkpoints instead of full dp/parent arrays.
+    int dpBand = 0;                // Initial half-width of the banded DP corridor (0 = full DP).
+    std::vector<int> predictedSeam; // Previous vertical seam in current coordinates (banded DP).
+    int dpBlockHeight = 0;         // Row-block height of the multithreaded DP (0 = sequential DP).
+    int dpRowsPerStep = 0;         // Rows per synchronisation of the strip-tiled DP (0 = sequential DP).
+    bool transposeHorizontal = false; // Carve horizontal seams as vertical seams of the transposed image.
+    bool transposed = false;       // True while image and its layers are held transposed.
+    int seamsPerPass = 1;          // Maximum number of disjoint vertical seams extracted from one DP pass.
+    bool incrementalEnergy = true; // Patch the persistent energy map instead of recomputing it per seam.
+    bool lazyGreedyEnergy = true;  // Greedy seams evaluate the energy of the pixels they probe only.
+    int greedyBeam = 1;            // Partial paths kept by the greedy search (1 = single greedy walk).
+    bool greedyAllStarts = false;  // Greedy search walks from every start position and keeps the cheapest walk.
+    bool lazyEnergy = false;       // Set per job: seams read energy through energyProbe, no map is kept.
+    EnergyProbeFn energyProbe = nullptr; // Per-pixel energy kernel of the current job (lazy energy only).
+    bool grayOnly = false;         // Set per job: forward-energy seams read gray only, no energy map is kept.
+    bool energyValid = false;      // True when gray/energy (gray alone with grayOnly) match the current image.
+    int maskRemoveCount = 0;       // MaskLabel::Remove pixels still in the image.
+    SeamDPCache dpCache;           // Vertical DP carried between seams (incremental energy only).
+    float maskBias[3] = { 0.f, 0.f, 0.f }; // Additive seam cost per MaskLabel, set once per resize job.
+
+    using SeamFinder = std::vector<int> (SeamCarver::*)(const cv::Mat& energy);
+    SeamSearch seamSearch = SeamSearch::DP; // Seam search algorithm of the current strategy.
+    SeamFinder verticalSeamFinder = &SeamCarver::findVerticalSeamDP;     // Vertical finder of the strategy.
+    SeamFinder horizontalSeamFinder = &SeamCarver::findHorizontalSeamDP; // Horizontal finder of the strategy.
 
     /**
      * @brief Computes the energy map of the current image.
-     * @return A single-channel floating-point matrix representing per-pixel energy.
+     * Also refreshes the cached grayscale image used for incremental updates.
+     * @return A single-channel matrix representing per-pixel energy
+     *         (CV_32F, or CV_16U in integer mode).
      */
     cv::Mat computeEnergyMap();
 
+    /**
+     * @brief Returns the energy map for the current image.
+     * In incremental mode the persistent map is reused and only rebuilt when it
+     * is not in sync with the image; otherwise a fresh map is computed.
+     */
+    const cv::Mat& currentEnergyMap();
+
+    /**
+     * @brief Recomputes the energy of row y for columns [x0, x1] from the cached gray image
+     * (or the image itself for colour energies, or the integral images for the
+     * local-variance energy).
+     * Uses the same formula (with reflected borders) as computeEnergyMap(),
+     * including the integer L1 variant when the map is CV_16U.
+     */
+    void refreshEnergySpan(int y, int x0, int x1);
+
+    /**
+     * @brief Seam cost of n pixels evaluated on demand (lazy energy): the energy of each
+     * pixel's neighbourhood from energyProbe, plus saliency and mask bias, exactly as the
+     * energy map and the seam finders would combine them.
+     *
+     * @param pixels Pixels to evaluate.
+     * @param n      Number of pixels.
+     * @param cost   Receives the n costs.
+     */
+    void probeSeamCost(const cv::Point* pixels, int n, float* cost) const;
+
+    /**
+     * @brief Sets the per-label mask bias for the current resize job.
+     * The magnitude exceeds the cost of any mask-free seam (twice the largest pixel
+     * cost times the longest seam), so a single protected pixel outweighs the whole
+     * path and a single removal pixel undercuts it, for both float and uint16 energy.
+     */
+    void updateMaskBias();
+
     /**
      * @brief Finds a vertical seam of minimum energy.
      * A vertical seam is one pixel per row, connected from top to bottom.
@@ -32,6 +149,26 @@ private:
      */
     std::vector<int> findVerticalSeam(const cv::Mat& energy);
 
+    /**
+     * @brief Specialised vertical seam finders of the seam strategies (see selectSeamFinders()).
+     */
+    std::vector<int> findVerticalSeamDP(const cv::Mat& energy);
+    std::vector<int> findVerticalSeamForwardDP(const cv::Mat& energy);
+    std::vector<int> findVerticalSeamGreedy(const cv::Mat& energy);
+    std::vector<int> findVerticalSeamGreedyLazy(const cv::Mat& energy);
+    std::vector<int> findVerticalSeamMultiStart(const cv::Mat& energy);
+    std::vector<int> findVerticalSeamBeam(const cv::Mat& energy);
+
+    /**
+     * @brief Finds up to count vertical seams that neither cross nor touch.
+     * With the full DP all seams come from one DP pass; otherwise a single seam is returned.
+     *
+     * @param energy Pre-computed energy map of the image.
+     * @param count  Maximum number of seams.
+     * @return Seams as vectors of x-coordinates (at least one).
+     */
+    std::vector<std::vector<int>> findVerticalSeams(const cv::Mat& energy, int count);
+
     /**
      * @brief Finds a horizontal seam of minimum energy.
      * A horizontal seam is one pixel per column, connected left to right.
@@ -41,6 +178,21 @@ private:
      */
     std::vector<int> findHorizontalSeam(const cv::Mat& energy);
 
+    /**
+     * @brief Specialised horizontal seam finders of the seam strategies (see selectSeamFinders()).
+     */
+    std::vector<int> findHorizontalSeamDP(const cv::Mat& energy);
+    std::vector<int> findHorizontalSeamForwardDP(const cv::Mat& energy);
+    std::vector<int> findHorizontalSeamGreedy(const cv::Mat& energy);
+    std::vector<int> findHorizontalSeamGreedyLazy(const cv::Mat& energy);
+    std::vector<int> findHorizontalSeamMultiStart(const cv::Mat& energy);
+    std::vector<int> findHorizontalSeamBeam(const cv::Mat& energy);
+
+    /**
+     * @brief Points findVerticalSeam() / findHorizontalSeam() at the finders of a search algorithm.
+     */
+    void selectSeamFinders(SeamSearch search);
+
     /**
      * @brief Removes a vertical seam from the image.
      * Given a seam specifying one column index per row, this function shifts the
@@ -59,15 +211,258 @@ private:
      */
     void removeHorizontalSeam(const std::vector<int>& seam);
 
+    /**
+     * @brief Transposes the working image and its mask and saliency layers.
+     * Switches between the original and the transposed orientation; the energy map
+     * and DP state are rebuilt afterwards.
+     */
+    void transposeLayers();
+
 public:
     /**
      * @brief Constructs a new SeamCarver with an initial image.
-     * The provided image is copied into internal storage and manipulated
-     * during the seam carving process.
+     * The provided image is copied into internal storage, which seams are then
+     * removed from in place. The first SeamCarver probes the CPU and
+     * selects the widest SimdKernels variant for the energy and DP kernels.
      *
      * @param img Input BGR image.
      */
-    SeamCarver(const cv::Mat& img) : image(img) {};
+    SeamCarver(const cv::Mat& img) : image(img.clone()) { selectSimdKernels(); };
+
+    /**
+     * @brief Enables or disables incremental energy maintenance.
+     * When enabled (default), the energy map is computed once and afterwards only the
+     * band around each removed seam (seam +-2 px, the 3x3 Sobel support) is recomputed.
+     * When disabled, the full energy map is recomputed before every seam.
+     *
+     * @param enable True to patch the energy map incrementally.
+     */
+    void setIncrementalEnergy(bool enable) { incrementalEnergy = enable; energyValid = false; }
+
+    /**
+     * @brief Selects the kernel used to compute full energy maps.
+     * All engines produce the same Sobel gradient-magnitude energy; the fused
+     * engine avoids the full-size gray/gradient temporaries of the OpenCV path,
+     * and the parallel engine runs it on stripes across cv::getNumThreads() threads.
+     *
+     * @param engine Energy engine to use for subsequent resize calls.
+     */
+    void setEnergyEngine(EnergyEngine engine) { energyEngine = engine; energyValid = false; }
+
+    /**
+     * @brief Enables or disables the integer energy pipeline.
+     * When enabled, energy is computed from 8-bit gray with int16 Sobel responses and
+     * stored as CV_16U L1 magnitude |gx| + |gy|, avoiding float conversion and sqrt.
+     * The default float (CV_32F, L2) mode is kept for comparison with earlier results.
+     *
+     * @param enable True to use the uint16 energy map.
+     */
+    void setIntegerEnergy(bool enable) { integerEnergy = enable; energyValid = false; }
+
+    /**
+     * @brief Selects the energy function as a compile-time policy.
+     * Energy is one of the functors from EnergyKernels.h (SobelEnergy, ScharrEnergy,
+     * GradientL1Energy, DualGradientEnergy, ColourGradientEnergy) or any type with the
+     * same static interface. Its per-pixel function is inlined into specialised row
+     * kernels, which are dispatched once per map, so there is no per-pixel virtual call.
+     * SobelEnergy (default) keeps the engine and integer options; other functors
+     * produce CV_32F maps and run single-threaded or, with EnergyEngine::Parallel, on stripes.
+     */
+    template <class Energy>
+    void setEnergyFunction() { energyKernels = energyKernelsFor<Energy>(); energyValid = false; }
+
+    /**
+     * @brief Selects the local-variance energy (window standard deviation of gray).
+     * Texture-heavy regions (foliage, fabric) give noisy Sobel energy; a windowed
+     * variance is smoother. Window sums are read from integral images, so any window
+     * size costs O(1) per pixel, and after each seam the integrals are updated in place
+     * of being rebuilt: only the columns (rows) between the extreme seam positions are
+     * recomputed, the rest is shifted. Takes precedence over the energy function and
+     * produces a CV_32F map.
+     *
+     * @param radius Window radius (window is 2 * radius + 1 pixels wide), or 0 to disable.
+     */
+    void setVarianceEnergy(int radius) { varianceRadius = radius; energyValid = false; }
+
+    /**
+     * @brief Blends spectral-residual saliency (Hou & Zhang) into the energy.
+     * Saliency is computed once per resize job on a small proxy of the image with
+     * cv::dft, upsampled, and then compacted alongside the image like the other
+     * layers, so it costs nothing per seam. The energy becomes
+     * gradient + weight * saliency (saliency in [0, 1], x255 for the uint16 map).
+     *
+     * @param weight Weight of the saliency term, or 0 to disable it.
+     */
+    void setSaliencyWeight(float weight) { saliencyWeight = weight; energyValid = false; }
+
+    /**
+     * @brief Selects the seam strategy as a compile-time policy.
+     * Strategy is DPSeams (default), ForwardDPSeams or GreedySeams. Each has its own
+     * specialised vertical and horizontal seam finders; the carver switches between
+     * them through one member-function pointer per orientation, set here, so a single
+     * binary serves both preview (greedy) and final (DP) jobs without the hot loops
+     * ever testing the strategy.
+     */
+    template <class Strategy>
+    void setSeamStrategy() { selectSeamFinders(Strategy::search); }
+
+    /**
+     * @brief Enables or disables forward-energy seam selection (Rubinstein et al.).
+     * When enabled, the DP minimises the gradient introduced between the pixels that
+     * become neighbours once the seam is removed (costs C_L / C_U / C_R), computed
+     * inline from the gray rows inside the DP loop. Such jobs keep only gray compacted
+     * with the image; the backward energy map is built once, for the mask bias, when a
+     * mask is set. Enabling is shorthand for
+     * setSeamStrategy<ForwardDPSeams>(); disabling only turns ForwardDPSeams back into
+     * DPSeams and leaves any other strategy (e.g. GreedySeams) selected.
+     *
+     * @param enable True to use forward energy, false for the backward energy map.
+     */
+    void setForwardEnergy(bool enable)
+    {
+        if (enable)
+            selectSeamFinders(SeamSearch::ForwardDP);
+        else if (seamSearch == SeamSearch::ForwardDP)
+            selectSeamFinders(SeamSearch::DP);
+    }
+
+    /**
+     * @brief Enables or disables lazy energy for greedy seams.
+     * The greedy walk reads three pixels per row, so when enabled (default) GreedySeams
+     * jobs keep no energy map: the energy of each probed pixel is computed on demand from
+     * its 3x3 BGR neighbourhood (plus saliency and mask bias), and seams cost O(W + H)
+     * (one scan of the first row, three pixels per row after it) instead of O(W * H).
+     * The local-variance energy needs its integral images and keeps the map.
+     *
+     * @param enable True to evaluate greedy energy lazily.
+     */
+    void setLazyGreedyEnergy(bool enable) { lazyGreedyEnergy = enable; }
+
+    /**
+     * @brief Sets the beam width of the greedy search.
+     * With a width B > 1 the greedy search keeps the B cheapest partial seams instead of
+     * a single walk: every line extends each kept seam to its three neighbours, keeps the
+     * cheapest seam reaching each pixel and the B cheapest of those, and the cheapest
+     * complete seam is returned. Costs O(B * H) evaluated pixels plus a sort of 3B
+     * candidates per line, a quality/latency knob between the single greedy walk (B = 1)
+     * and the full DP. Works on the lazy energy as well as on the energy map. Lines depend
+     * on each other, so the beam runs scalar on the calling thread; the walks from every
+     * start (setMultiStartGreedy()) are the SIMD, multithreaded alternative.
+     *
+     * @param width Number of partial seams kept per line (1 = single greedy walk).
+     */
+    void setGreedyBeam(int width) { greedyBeam = std::max(width, 1); }
+
+    /**
+     * @brief Enables the multi-start greedy search.
+     * A greedy walk is started from every position of the first line and the walk with
+     * the lowest total cost is kept. The walks are independent: they run in SIMD lanes
+     * (one gather of the three candidates per lane and line) on chunks spread over
+     * cv::getNumThreads() threads, reading a padded float copy of the energy map. Every
+     * pixel's cost is read, so this mode uses the energy map rather than lazy energy;
+     * it takes precedence over the beam width. With a mask set the copy and the totals
+     * are double (see setMask()) and each walk runs scalar, still spread over threads.
+     *
+     * @param enable True to walk from every start position.
+     */
+    void setMultiStartGreedy(bool enable) { greedyAllStarts = enable; }
+
+    /**
+     * @brief Enables or disables the low-memory DP.
+     * Instead of full dp and parent arrays, the DP keeps two rolling rows plus a
+     * checkpoint row every sqrt(H) rows and rebuilds the seam by recomputing one
+     * segment between checkpoints at a time during backtracking. DP memory drops from
+     * O(W * H) to O(W * sqrt(H)) at the cost of roughly one extra DP pass; seams are
+     * unchanged. Applies to the backward-energy DP (vertical and horizontal seams).
+     *
+     * @param enable True to use the checkpointed DP.
+     */
+    void setLowMemoryDP(bool enable) { lowMemoryDP = enable; }
+
+    /**
+     * @brief Enables the banded DP for vertical seams.
+     * Consecutive seams tend to lie close together, so after the first seam the DP only
+     * evaluates a corridor of +-halfWidth columns around the previous seam, costing
+     * O(H * band) instead of O(H * W) per seam. When the best path touches a corridor edge
+     * inside the image the corridor is doubled and the DP repeated, until the path stays
+     * clear of the edges or the corridor spans the image. Seams are optimal within the
+     * corridor only. Applies to the backward-energy DP while no object is being removed;
+     * replaces the carried DP when set. Multi-seam passes (setSeamsPerPass()) need the DP
+     * of the whole image and use the full DP instead.
+     *
+     * @param halfWidth Initial corridor half-width in columns, or 0 for the full DP.
+     */
+    void setBandedDP(int halfWidth) { dpBand = std::max(halfWidth, 0); }
+
+    /**
+     * @brief Enables the multithreaded row-block DP for vertical seams.
+     * The rows are cut into blocks; each block's column-to-column (min, +) transfer, a
+     * band of 2 * blockHeight + 1 columns, is built in parallel, the block-end rows are
+     * stitched in order (each step parallel over columns), and the blocks are relaxed
+     * again in parallel to recover the parents for backtracking. It does about
+     * blockHeight + 3 times the work of the sequential DP, so it pays off with many
+     * cores on tall images. Applies to the backward-energy DP, including multi-seam
+     * passes (setSeamsPerPass()); the banded DP takes precedence, and the carried DP is
+     * not used.
+     *
+     * @param blockHeight Rows per block, or 0 for the sequential DP.
+     */
+    void setParallelDP(int blockHeight) { dpBlockHeight = std::max(blockHeight, 0); }
+
+    /**
+     * @brief Enables the multithreaded strip-tiled DP for vertical seams.
+     * The columns are split into one strip per thread, and each strip advances
+     * rowsPerStep rows per synchronisation step from the shared DP row above, recomputing
+     * a halo of rowsPerStep columns on each side that narrows by one column per row
+     * (trapezoid tiles). Threads synchronise H / rowsPerStep times per seam instead of
+     * H times, the extra work is the halos, and seams are identical to the sequential DP.
+     * Applies to the backward-energy DP, including multi-seam passes (setSeamsPerPass());
+     * the banded and row-block DPs take precedence, and the carried DP is not used.
+     *
+     * @param rowsPerStep Rows per synchronisation step, or 0 for the sequential DP.
+     */
+    void setTiledDP(int rowsPerStep) { dpRowsPerStep = std::max(rowsPerStep, 0); }
+
+    /**
+     * @brief Enables carving horizontal seams on a transposed copy of the image.
+     * The horizontal seam finder walks the DP column by column and the horizontal removal
+     * copies one pixel-wide column at a time, both striding through memory. In this mode
+     * the image (with its mask and saliency) is transposed when carving switches to
+     * horizontal seams and back when it switches to vertical ones, so horizontal seams
+     * run through the row-major vertical energy, DP and removal kernels, including the
+     * DP options and seams per pass. Each switch costs one transpose and one energy map.
+     *
+     * @param enable True to carve horizontal seams on the transposed image.
+     */
+    void setTransposedHorizontal(bool enable) { transposeHorizontal = enable; }
+
+    /**
+     * @brief Sets how many vertical seams are removed per DP pass.
+     * After one full DP the k best end columns are backtracked in cost order and every
+     * path that runs into a pixel claimed by (or adjacent to) an earlier seam is skipped,
+     * giving up to k non-crossing, non-touching seams that are removed in one compaction.
+     * Trades a little optimality for about k times fewer energy updates and DP passes on
+     * large width reductions. Only the backward-energy DP batches seams; the pass runs on
+     * the row-block or strip-tiled DP when one is set and on the full DP otherwise (the
+     * banded DP is not used). While an object is being removed one seam is taken per pass.
+     *
+     * @param count Maximum number of seams per pass (1 = one optimal seam per pass).
+     */
+    void setSeamsPerPass(int count) { seamsPerPass = std::max(count, 1); }
+
+    /**
+     * @brief Attaches a protect/remove mask to the image.
+     * The mask is a CV_8U layer of MaskLabel values with the size of the current image.
+     * It is compacted in the same loop as the image pixels and enters the seam search
+     * as an additive bias on the cost read, so it costs no extra pass over the image.
+     * The bias outweighs the energy of any seam, so the DPs accumulate costs in double
+     * while a mask is set (float otherwise). While MaskLabel::Remove pixels are present,
+     * resize() stops as soon as the last of them has been carved away (the target size
+     * then only acts as a limit).
+     *
+     * @param labels Mask of MaskLabel values, or an empty matrix to remove the mask.
+     */
+    void setMask(const cv::Mat& labels);
 
     /**
      * @brief Resizes the image to a target width and height using seam carving.
@@ -77,8 +472,42 @@ public:
      */
     void resize(int targetWidth, int targetHeight);
 
+    /**
+     * @brief Resizes the image with the given seam strategy (see setSeamStrategy()).
+     *
+     * @param targetWidth  The desired final width of the image.
+     * @param targetHeight The desired final height of the image.
+     */
+    template <class Strategy>
+    void resize(int targetWidth, int targetHeight) { setSeamStrategy<Strategy>(); resize(targetWidth, targetHeight); }
+
+    /**
+     * @brief Removes several vertical seams that share no pixel in one compaction.
+     * All seams index the current image (e.g. seams recorded from an earlier run or
+     * several seams from one DP pass). Each row is sorted once and the runs between
+     * its seam columns are moved in place, so k seams cost one pass over the image
+     * instead of k; the image width shrinks by the number of seams.
+     * Throws cv::Exception unless every seam has one 8-connected entry per row.
+     *
+     * @param seams Vector of seams, each a vector of x-coordinates.
+     */
+    void removeVerticalSeams(const std::vector<std::vector<int>>& seams);
+
+    /**
+     * @brief Removes several horizontal seams that share no pixel in one compaction.
+     * Horizontal counterpart of removeVerticalSeams(): every pixel moves up by the
+     * number of seams above it in its column, in one top-to-bottom pass.
+     * Throws cv::Exception unless every seam has one 8-connected entry per column.
+     *
+     * @param seams Vector of seams, each a vector of y-coordinates.
+     */
+    void removeHorizontalSeams(const std::vector<std::vector<int>>& seams);
+
     /**
      * @brief Retrieves the current processed image.
+     * Seams are removed in place, so this is an ROI header over the carver's buffer
+     * (rows keep the original stride); clone it to keep it across further carving.
+     *
      * @return The modified image after carving operations.
      */
     cv::Mat getImage() const { return image; };
@@ -0,0 +1,34 @@
+//// SimdKernels.cpp
+// Baseline build of the dispatched kernels (the compiler's default instruction set)
+// and the one-time CPU probe.
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SIMD_KERNELS_NAME "NEON"
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_KERNELS_NAME "SSE2"
+#else
+#define SIMD_KERNELS_NAME "scalar"
+#endif
+#define SIMD_KERNELS_NAMESPACE simd_baseline
+#include "SimdKernels.simd.hpp"
+
+const SimdKernels* activeSimdKernels = &simd_baseline::kernels;
+
+const SimdKernels& selectSimdKernels()
+{
+    // The probe and the write of activeSimdKernels run once, inside the thread-safe
+    // initialisation of the local static, so concurrent constructors do not race
+    static const SimdKernels* selected = [] {
+        const SimdKernels* kernels = &simd_baseline::kernels;
+        const SimdKernels* avx512 = simdKernelsAVX512();
+        const SimdKernels* avx2 = simdKernelsAVX2();
+        if (avx512 && cv::checkHardwareSupport(CV_CPU_AVX512_SKX))
+            kernels = avx512;
+        else if (avx2 && cv::checkHardwareSupport(CV_CPU_AVX2) && cv::checkHardwareSupport(CV_CPU_FMA3))
+            kernels = avx2;
+
+        activeSimdKernels = kernels;
+        return kernels;
+    }();
+
+    return *selected;
+}
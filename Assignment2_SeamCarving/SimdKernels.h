@@ -0,0 +1,71 @@
+#pragma once
+#include "opencv2/core.hpp"
+
+/**
+ * @file SimdKernels.h
+ * @brief CPU-dispatched row kernels of the energy and DP stages.
+ *
+ * The hot row kernels (gray conversion, fused Sobel, colour gradient, DP row
+ * relaxation, argmin and the multi-start greedy walks) live in SimdKernels.simd.hpp
+ * and are compiled once per instruction set: for the build baseline in
+ * SimdKernels.cpp (SSE2 on x86-64, NEON on AArch64) and with AVX2 / AVX-512 code
+ * generation in SimdKernels_avx2.cpp and SimdKernels_avx512.cpp. A variant whose
+ * file was built without its compiler flags is left out.
+ *
+ * selectSimdKernels() probes the CPU once (SeamCarver's constructor calls it) and
+ * installs the widest variant the CPU supports; callers fetch the table through
+ * simdKernels() once per row, so one binary runs the wide kernels where they exist.
+ */
+
+/**
+ * @brief DP row relaxation kernel over an energy row of type T (see relaxVerticalRow).
+ */
+template <typename T>
+using RelaxRowFn = void (*)(const float* prev, float* cur, schar* parent, const T* eRow, int cols);
+
+/**
+ * @brief Table of row kernels compiled for one instruction set.
+ */
+struct SimdKernels {
+    const char* name; // Instruction set the kernels were compiled for.
+    int floatLanes;   // float lanes per vector.
+
+    void (*grayRowF32)(const uchar* bgr, uchar* g8, float* gpad, int cols);
+    void (*grayRowS16)(const uchar* bgr, uchar* g8, short* gpad, int cols);
+    void (*sobelMagnitudeRow)(const float* p0, const float* p1, const float* p2, float* dst, int cols);
+    void (*sobelL1Row)(const short* p0, const short* p1, const short* p2, ushort* dst, int cols);
+    int (*colourGradientSpan)(const uchar* up, const uchar* mid, const uchar* dn, float* out, int x, int cols);
+    RelaxRowFn<float> relaxRowF32;
+    RelaxRowFn<ushort> relaxRowU16;
+    int (*argminRow)(const float* v, int n);
+    void (*greedyWalks)(const float* const* lines, int count, int* pos, float* total, int n);
+
+    /**
+     * @brief Returns the DP row kernel for the energy type of eRow.
+     */
+    RelaxRowFn<float> relaxRow(const float* /*eRow*/) const { return relaxRowF32; }
+    RelaxRowFn<ushort> relaxRow(const ushort* /*eRow*/) const { return relaxRowU16; }
+};
+
+// Kernel table in use; the baseline variant until selectSimdKernels() runs.
+extern const SimdKernels* activeSimdKernels;
+
+/**
+ * @brief Returns the kernel table in use.
+ */
+inline const SimdKernels& simdKernels()
+{
+    return *activeSimdKernels;
+}
+
+/**
+ * @brief Probes the CPU on the first call and installs the widest supported variant.
+ * Respects OpenCV's OPENCV_CPU_DISABLE environment variable (e.g. AVX512_SKX,AVX2).
+ *
+ * @return The installed kernel table.
+ */
+const SimdKernels& selectSimdKernels();
+
+// Variants built in their own translation units; nullptr when built without the ISA flags.
+const SimdKernels* simdKernelsAVX2();
+const SimdKernels* simdKernelsAVX512();
@@ -0,0 +1,488 @@
+//// SimdKernels.simd.hpp
+// Kernel bodies shared by all SimdKernels variants. Each including translation unit
+// selects the instruction set (CV_* macros / compiler flags) and defines
+// SIMD_KERNELS_NAMESPACE and SIMD_KERNELS_NAME first, so every variant lands in its
+// own namespace. The kernels work on raw row pointers and only call universal
+// intrinsics, which OpenCV also places in a per-instruction-set namespace, C library
+// functions and the static helpers below. Inline std:: templates (std::min,
+// std::sqrt(float), ...) must not be used here: their out-of-line copies (e.g. at -O0)
+// are weak symbols built with this variant's ISA flags, and the linker may keep that
+// copy for the baseline callers as well.
+#include "SimdKernels.h"
+#include "opencv2/core/hal/intrin.hpp"
+#include <math.h>
+#include <stdlib.h>
+
+#if !defined(SIMD_KERNELS_NAMESPACE) || !defined(SIMD_KERNELS_NAME)
+#error "define SIMD_KERNELS_NAMESPACE and SIMD_KERNELS_NAME before including SimdKernels.simd.hpp"
+#endif
+
+namespace SIMD_KERNELS_NAMESPACE {
+
+// BGR2GRAY fixed-point coefficients (Q14), identical to cv::cvtColor
+constexpr int B2Y = 1868;
+constexpr int G2Y = 9617;
+constexpr int R2Y = 4899;
+constexpr int GRAY_SHIFT = 14;
+
+/**
+ * @brief Scalar min of the kernel tails (internal linkage, see the file comment).
+ */
+static inline float minScalar(float a, float b)
+{
+    return b < a ? b : a;
+}
+
+/**
+ * @brief Stores one vector of 16-bit gray values into a padded float row.
+ */
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static inline void storeGrayLanes(float* dst, const cv::v_uint16& y16)
+{
+    const int fl = cv::VTraits<cv::v_float32>::vlanes();
+    cv::v_uint32 lo, hi;
+    cv::v_expand(y16, lo, hi);
+    cv::v_store(dst, cv::v_cvt_f32(cv::v_reinterpret_as_s32(lo)));
+    cv::v_store(dst + fl, cv::v_cvt_f32(cv::v_reinterpret_as_s32(hi)));
+}
+
+/**
+ * @brief Stores one vector of 16-bit gray values into a padded int16 row.
+ */
+static inline void storeGrayLanes(short* dst, const cv::v_uint16& y16)
+{
+    cv::v_store(dst, cv::v_reinterpret_as_s16(y16));
+}
+#endif
+
+/**
+ * @brief Converts one BGR row to gray, writing the 8-bit value (optional) and a
+ * padded copy (float or int16) used by the Sobel stage.
+ *
+ * @param bgr  Source row (cols pixels, interleaved BGR).
+ * @param g8   Destination 8-bit gray row, or nullptr.
+ * @param gpad Destination row with one pixel of padding on each side
+ *             (gpad[x + 1] holds column x); the caller fills the padding.
+ * @param cols Row width in pixels.
+ */
+template <typename PadT>
+static void grayRow(const uchar* bgr, uchar* g8, PadT* gpad, int cols)
+{
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vl = cv::VTraits<cv::v_uint8>::vlanes();
+    const int hl = cv::VTraits<cv::v_uint16>::vlanes();
+    const cv::v_uint32 vb = cv::vx_setall_u32(B2Y);
+    const cv::v_uint32 vg = cv::vx_setall_u32(G2Y);
+    const cv::v_uint32 vr = cv::vx_setall_u32(R2Y);
+    const cv::v_uint32 vhalf = cv::vx_setall_u32(1 << (GRAY_SHIFT - 1));
+
+    for (; x <= cols - vl; x += vl)
+    {
+        cv::v_uint8 b, g, r;
+        cv::v_load_deinterleave(bgr + 3 * x, b, g, r);
+
+        cv::v_uint16 b16[2], g16[2], r16[2];
+        cv::v_expand(b, b16[0], b16[1]);
+        cv::v_expand(g, g16[0], g16[1]);
+        cv::v_expand(r, r16[0], r16[1]);
+
+        cv::v_uint16 y16[2];
+        for (int h = 0; h < 2; ++h)
+        {
+            cv::v_uint32 b32[2], g32[2], r32[2], y32[2];
+            cv::v_expand(b16[h], b32[0], b32[1]);
+            cv::v_expand(g16[h], g32[0], g32[1]);
+            cv::v_expand(r16[h], r32[0], r32[1]);
+            for (int q = 0; q < 2; ++q)
+            {
+                cv::v_uint32 acc = cv::v_add(cv::v_mul(b32[q], vb), cv::v_mul(g32[q], vg));
+                acc = cv::v_add(acc, cv::v_add(cv::v_mul(r32[q], vr), vhalf));
+                y32[q] = cv::v_shr<GRAY_SHIFT>(acc);
+            }
+            y16[h] = cv::v_pack(y32[0], y32[1]);
+            storeGrayLanes(gpad + 1 + x + h * hl, y16[h]);
+        }
+        if (g8)
+            cv::v_store(g8 + x, cv::v_pack(y16[0], y16[1]));
+    }
+#endif
+    for (; x < cols; ++x)
+    {
+        const uchar* p = bgr + 3 * x;
+        const int v = (p[0] * B2Y + p[1] * G2Y + p[2] * R2Y + (1 << (GRAY_SHIFT - 1))) >> GRAY_SHIFT;
+        if (g8)
+            g8[x] = static_cast<uchar>(v);
+        gpad[x + 1] = static_cast<PadT>(v);
+    }
+}
+
+/**
+ * @brief Sobel L2 magnitude of one row from three padded float gray rows.
+ */
+static void sobelMagnitudeRow(const float* p0, const float* p1, const float* p2, float* dst, int cols)
+{
+    constexpr float scale = 1.0f / 255.0f;
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int fl = cv::VTraits<cv::v_float32>::vlanes();
+    const cv::v_float32 vscale = cv::vx_setall_f32(scale);
+
+    for (; x <= cols - fl; x += fl)
+    {
+        // padded index x + k corresponds to column x + k - 1
+        cv::v_float32 a0 = cv::vx_load(p0 + x), a1 = cv::vx_load(p0 + x + 1), a2 = cv::vx_load(p0 + x + 2);
+        cv::v_float32 b0 = cv::vx_load(p1 + x), b2 = cv::vx_load(p1 + x + 2);
+        cv::v_float32 c0 = cv::vx_load(p2 + x), c1 = cv::vx_load(p2 + x + 1), c2 = cv::vx_load(p2 + x + 2);
+
+        cv::v_float32 gx = cv::v_add(cv::v_add(cv::v_sub(a2, a0), cv::v_sub(c2, c0)),
+                                     cv::v_add(cv::v_sub(b2, b0), cv::v_sub(b2, b0)));
+        cv::v_float32 gy = cv::v_add(cv::v_add(cv::v_sub(c0, a0), cv::v_sub(c2, a2)),
+                                     cv::v_add(cv::v_sub(c1, a1), cv::v_sub(c1, a1)));
+
+        gx = cv::v_mul(gx, vscale);
+        gy = cv::v_mul(gy, vscale);
+        cv::v_store(dst + x, cv::v_sqrt(cv::v_add(cv::v_mul(gx, gx), cv::v_mul(gy, gy))));
+    }
+#endif
+    for (; x < cols; ++x)
+    {
+        const float gx = (p0[x + 2] - p0[x]) + (p2[x + 2] - p2[x]) + 2.0f * (p1[x + 2] - p1[x]);
+        const float gy = (p2[x] - p0[x]) + (p2[x + 2] - p0[x + 2]) + 2.0f * (p2[x + 1] - p0[x + 1]);
+        const float fx = gx * scale;
+        const float fy = gy * scale;
+        dst[x] = sqrtf(fx * fx + fy * fy);
+    }
+}
+
+/**
+ * @brief Sobel L1 magnitude |gx| + |gy| of one row from three padded int16 gray rows.
+ * Responses fit in int16 (|g| <= 4 * 255) and their sum in uint16 (<= 2040).
+ */
+static void sobelL1Row(const short* p0, const short* p1, const short* p2, ushort* dst, int cols)
+{
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int hl = cv::VTraits<cv::v_int16>::vlanes();
+
+    for (; x <= cols - hl; x += hl)
+    {
+        cv::v_int16 a0 = cv::vx_load(p0 + x), a1 = cv::vx_load(p0 + x + 1), a2 = cv::vx_load(p0 + x + 2);
+        cv::v_int16 b0 = cv::vx_load(p1 + x), b2 = cv::vx_load(p1 + x + 2);
+        cv::v_int16 c0 = cv::vx_load(p2 + x), c1 = cv::vx_load(p2 + x + 1), c2 = cv::vx_load(p2 + x + 2);
+
+        cv::v_int16 gx = cv::v_add(cv::v_add(cv::v_sub(a2, a0), cv::v_sub(c2, c0)),
+                                   cv::v_add(cv::v_sub(b2, b0), cv::v_sub(b2, b0)));
+        cv::v_int16 gy = cv::v_add(cv::v_add(cv::v_sub(c0, a0), cv::v_sub(c2, a2)),
+                                   cv::v_add(cv::v_sub(c1, a1), cv::v_sub(c1, a1)));
+
+        cv::v_store(dst + x, cv::v_add(cv::v_abs(gx), cv::v_abs(gy)));
+    }
+#endif
+    for (; x < cols; ++x)
+    {
+        const int gx = (p0[x + 2] - p0[x]) + (p2[x + 2] - p2[x]) + 2 * (p1[x + 2] - p1[x]);
+        const int gy = (p2[x] - p0[x]) + (p2[x + 2] - p0[x + 2]) + 2 * (p2[x + 1] - p0[x + 1]);
+        dst[x] = static_cast<ushort>(abs(gx) + abs(gy));
+    }
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+/**
+ * @brief Widens 8-bit lanes to two int16 halves.
+ */
+static inline void widenS16(const cv::v_uint8& v, cv::v_int16& lo, cv::v_int16& hi)
+{
+    cv::v_uint16 a, b;
+    cv::v_expand(v, a, b);
+    lo = cv::v_reinterpret_as_s16(a);
+    hi = cv::v_reinterpret_as_s16(b);
+}
+#endif
+
+/**
+ * @brief SIMD part of the colour-gradient kernel (ColourGradientEnergy) on interleaved CV_8UC3 rows.
+ *
+ * Uses deinterleaving loads to get the B, G and R planes of the 3x3 neighbourhood
+ * straight from the interleaved rows, computes the per-channel Sobel responses in
+ * int16 and reduces the squared responses of all channels in int32 registers.
+ *
+ * @param up   Row above (interleaved BGR).
+ * @param mid  Current row.
+ * @param dn   Row below.
+ * @param out  Energy row (written from x on).
+ * @param x    First column to compute (at least 1).
+ * @param cols Row width.
+ * @return First column not written; the caller finishes the row with the scalar kernel.
+ */
+static int colourGradientSpan(const uchar* up, const uchar* mid, const uchar* dn, float* out, int x, int cols)
+{
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    constexpr float scale = 1.0f / 255.0f;
+    const int vl = cv::VTraits<cv::v_uint8>::vlanes();
+    const int fl = cv::VTraits<cv::v_float32>::vlanes();
+    const cv::v_float32 vscale = cv::vx_setall_f32(scale);
+
+    // pixels [x, x + vl) need columns x - 1 .. x + vl, which must stay inside the row
+    for (; x + vl < cols; x += vl)
+    {
+        // [row][offset][channel]: rows up/mid/dn, offsets x-1/x/x+1, channels B/G/R
+        cv::v_uint8 px[3][3][3];
+        const uchar* rowPtr[3] = { up, mid, dn };
+        for (int r = 0; r < 3; ++r)
+            for (int o = 0; o < 3; ++o)
+            {
+                if (r == 1 && o == 1)
+                    continue; // centre pixel does not enter the 3x3 Sobel
+                cv::v_load_deinterleave(rowPtr[r] + 3 * (x + o - 1), px[r][o][0], px[r][o][1], px[r][o][2]);
+            }
+
+        cv::v_int32 acc[4];
+        for (int k = 0; k < 4; ++k)
+            acc[k] = cv::vx_setzero_s32();
+
+        for (int c = 0; c < 3; ++c)
+        {
+            cv::v_int16 uL[2], uM[2], uR[2], mL[2], mR[2], dL[2], dM[2], dR[2];
+            widenS16(px[0][0][c], uL[0], uL[1]);
+            widenS16(px[0][1][c], uM[0], uM[1]);
+            widenS16(px[0][2][c], uR[0], uR[1]);
+            widenS16(px[1][0][c], mL[0], mL[1]);
+            widenS16(px[1][2][c], mR[0], mR[1]);
+            widenS16(px[2][0][c], dL[0], dL[1]);
+            widenS16(px[2][1][c], dM[0], dM[1]);
+            widenS16(px[2][2][c], dR[0], dR[1]);
+
+            for (int h = 0; h < 2; ++h)
+            {
+                cv::v_int16 mx = cv::v_sub(mR[h], mL[h]);
+                cv::v_int16 gx = cv::v_add(cv::v_add(cv::v_sub(uR[h], uL[h]), cv::v_sub(dR[h], dL[h])), cv::v_add(mx, mx));
+                cv::v_int16 my = cv::v_sub(dM[h], uM[h]);
+                cv::v_int16 gy = cv::v_add(cv::v_add(cv::v_sub(dL[h], uL[h]), cv::v_sub(dR[h], uR[h])), cv::v_add(my, my));
+
+                cv::v_int32 gx0, gx1, gy0, gy1;
+                cv::v_mul_expand(gx, gx, gx0, gx1);
+                cv::v_mul_expand(gy, gy, gy0, gy1);
+                acc[2 * h] = cv::v_add(acc[2 * h], cv::v_add(gx0, gy0));
+                acc[2 * h + 1] = cv::v_add(acc[2 * h + 1], cv::v_add(gx1, gy1));
+            }
+        }
+
+        for (int k = 0; k < 4; ++k)
+            cv::v_store(out + x + k * fl, cv::v_mul(cv::v_sqrt(cv::v_cvt_f32(acc[k])), vscale));
+    }
+#endif
+    return x;
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+/**
+ * @brief Loads one vector of energy values as float (CV_32F or CV_16U maps).
+ */
+static inline cv::v_float32 loadEnergyLanes(const float* p)
+{
+    return cv::vx_load(p);
+}
+
+static inline cv::v_float32 loadEnergyLanes(const ushort* p)
+{
+    return cv::v_cvt_f32(cv::v_reinterpret_as_s32(cv::vx_load_expand(p)));
+}
+#endif
+
+/**
+ * @brief Relaxes one row of the vertical DP: cur[x] = energy(x) + min(prev[x-1], prev[x], prev[x+1]).
+ *
+ * prev and cur point at column 0 of padded DP rows whose entries at -1 and cols hold
+ * +inf, so the three candidates are plain shifted loads with no edge checks. Each
+ * vector step takes the lane-wise min and argmin of the three candidates (ties keep
+ * the centre, then the left candidate, like the scalar loop) and adds the energy row.
+ * The argmin is kept as an offset (-1 / 0 / +1) and four vectors of offsets are
+ * packed into one vector of int8 parents.
+ *
+ * @param prev   Padded DP row y-1.
+ * @param cur    Padded DP row y (written).
+ * @param parent Parent offsets of row y (written).
+ * @param eRow   Energy row y.
+ * @param cols   Row width.
+ */
+template <typename T>
+static void relaxVerticalRow(const float* prev, float* cur, schar* parent, const T* eRow, int cols)
+{
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int fl = cv::VTraits<cv::v_float32>::vlanes();
+    const cv::v_int32 vright = cv::vx_setall_s32(1);
+
+    // one vector of columns starting at xs: stores cur, returns the parent offsets
+    auto relax = [&](int xs) {
+        const cv::v_float32 l = cv::vx_load(prev + xs - 1);
+        const cv::v_float32 c = cv::vx_load(prev + xs);
+        const cv::v_float32 r = cv::vx_load(prev + xs + 1);
+
+        // the all-ones compare mask is already the -1 offset of the left candidate
+        const cv::v_float32 takeLeft = cv::v_lt(l, c);
+        cv::v_float32 best = cv::v_select(takeLeft, l, c);
+        cv::v_int32 offset = cv::v_reinterpret_as_s32(takeLeft);
+
+        const cv::v_float32 takeRight = cv::v_lt(r, best);
+        best = cv::v_select(takeRight, r, best);
+        offset = cv::v_select(cv::v_reinterpret_as_s32(takeRight), vright, offset);
+
+        cv::v_store(cur + xs, cv::v_add(loadEnergyLanes(eRow + xs), best));
+        return offset;
+    };
+
+    for (; x <= cols - 4 * fl; x += 4 * fl)
+    {
+        const cv::v_int32 o0 = relax(x);
+        const cv::v_int32 o1 = relax(x + fl);
+        const cv::v_int32 o2 = relax(x + 2 * fl);
+        const cv::v_int32 o3 = relax(x + 3 * fl);
+        cv::v_store(parent + x, cv::v_pack(cv::v_pack(o0, o1), cv::v_pack(o2, o3)));
+    }
+#endif
+    for (; x < cols; ++x)
+    {
+        float bestCost = prev[x];
+        int bestX = x;
+        if (prev[x - 1] < bestCost) {
+            bestCost = prev[x - 1];
+            bestX = x - 1;
+        }
+        if (prev[x + 1] < bestCost) {
+            bestCost = prev[x + 1];
+            bestX = x + 1;
+        }
+
+        cur[x] = eRow[x] + bestCost;
+        parent[x] = static_cast<schar>(bestX - x);
+    }
+}
+
+/**
+ * @brief Returns the first index of the minimum of v[0..n).
+ * The minimum is reduced lane-wise, then the first block holding it is located.
+ */
+static int argminRow(const float* v, int n)
+{
+    int x = 0;
+    float minVal = v[0];
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int fl = cv::VTraits<cv::v_float32>::vlanes();
+    if (n >= fl)
+    {
+        cv::v_float32 vmin = cv::vx_load(v);
+        for (x = fl; x <= n - fl; x += fl)
+            vmin = cv::v_min(vmin, cv::vx_load(v + x));
+        minVal = cv::v_reduce_min(vmin);
+    }
+#endif
+    for (; x < n; ++x)
+        minVal = minScalar(minVal, v[x]);
+
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const cv::v_float32 vtarget = cv::vx_setall_f32(minVal);
+    for (; i <= n - fl; i += fl)
+        if (cv::v_check_any(cv::v_eq(cv::vx_load(v + i), vtarget)))
+            break;
+#endif
+    while (v[i] != minVal)
+        ++i;
+    return i;
+}
+
+/**
+ * @brief Advances n independent greedy walks through count padded cost lines.
+ *
+ * Walk i starts at position pos[i] of line 0 with total[i] holding its cost there;
+ * on every following line it moves to the cheapest of its three neighbours (ties keep
+ * the centre, then the left one, like the single greedy walk) and adds that cost.
+ * Lines are padded with +inf at index -1 and len, so the three candidates are plain
+ * gathers at pos - 1, pos and pos + 1 with no edge checks. One vector of walks is
+ * advanced per step, each lane gathering its own candidates.
+ *
+ * @param lines Padded cost lines (lines[k][p] is the cost of position p on line k).
+ * @param count Number of lines.
+ * @param pos   Start positions (in), end positions (out).
+ * @param total Costs at the start positions (in), total walk costs (out).
+ * @param n     Number of walks.
+ */
+static void greedyWalks(const float* const* lines, int count, int* pos, float* total, int n)
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int fl = cv::VTraits<cv::v_float32>::vlanes();
+    const cv::v_int32 vright = cv::vx_setall_s32(1);
+
+    for (; i <= n - fl; i += fl)
+    {
+        cv::v_int32 p = cv::vx_load(pos + i);
+        cv::v_float32 sum = cv::vx_load(total + i);
+        for (int k = 1; k < count; ++k)
+        {
+            const float* line = lines[k];
+            const cv::v_float32 l = cv::v_lut(line - 1, p);
+            const cv::v_float32 c = cv::v_lut(line, p);
+            const cv::v_float32 r = cv::v_lut(line + 1, p);
+
+            // the all-ones compare mask is already the -1 offset of the left candidate
+            const cv::v_float32 takeLeft = cv::v_lt(l, c);
+            cv::v_float32 best = cv::v_select(takeLeft, l, c);
+            cv::v_int32 offset = cv::v_reinterpret_as_s32(takeLeft);
+
+            const cv::v_float32 takeRight = cv::v_lt(r, best);
+            best = cv::v_select(takeRight, r, best);
+            offset = cv::v_select(cv::v_reinterpret_as_s32(takeRight), vright, offset);
+
+            p = cv::v_add(p, offset);
+            sum = cv::v_add(sum, best);
+        }
+        cv::v_store(pos + i, p);
+        cv::v_store(total + i, sum);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        int p = pos[i];
+        float sum = total[i];
+        for (int k = 1; k < count; ++k)
+        {
+            const float* line = lines[k];
+            int bestP = p;
+            if (line[p - 1] < line[bestP])
+                bestP = p - 1;
+            if (line[p + 1] < line[bestP])
+                bestP = p + 1;
+            p = bestP;
+            sum += line[p];
+        }
+        pos[i] = p;
+        total[i] = sum;
+    }
+}
+
+
+/**
+ * @brief Kernel table of this variant, installed by selectSimdKernels().
+ */
+const SimdKernels kernels = {
+    SIMD_KERNELS_NAME,
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    cv::VTraits<cv::v_float32>::max_nlanes,
+#else
+    1,
+#endif
+    grayRow<float>,
+    grayRow<short>,
+    sobelMagnitudeRow,
+    sobelL1Row,
+    colourGradientSpan,
+    relaxVerticalRow<float>,
+    relaxVerticalRow<ushort>,
+    argminRow,
+    greedyWalks
+};
+
+} // namespace SIMD_KERNELS_NAMESPACE
@@ -0,0 +1,30 @@
+//// SimdKernels_avx2.cpp
+// AVX2 build of the dispatched kernels (8 float lanes). Compile this file with
+// -mavx2 -mfma (GCC/Clang) or /arch:AVX2 (MSVC); otherwise the variant is left out.
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define CV_CPU_DISPATCH_MODE AVX2
+#define CV_SSE3 1
+#define CV_SSSE3 1
+#define CV_SSE4_1 1
+#define CV_SSE4_2 1
+#define CV_POPCNT 1
+#define CV_AVX 1
+#define CV_AVX2 1
+#define CV_FMA3 1
+#define SIMD_KERNELS_NAMESPACE simd_avx2
+#define SIMD_KERNELS_NAME "AVX2"
+#include "SimdKernels.simd.hpp"
+
+const SimdKernels* simdKernelsAVX2()
+{
+    return &simd_avx2::kernels;
+}
+#else
+#include "SimdKernels.h"
+
+const SimdKernels* simdKernelsAVX2()
+{
+    return nullptr;
+}
+#endif
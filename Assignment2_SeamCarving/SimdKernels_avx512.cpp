@@ -0,0 +1,37 @@
+//// SimdKernels_avx512.cpp
+// AVX-512 (Skylake-X feature set) build of the dispatched kernels (16 float lanes).
+// Compile this file with -mavx512f -mavx512cd -mavx512bw -mavx512dq -mavx512vl -mfma
+// (GCC/Clang) or /arch:AVX512 (MSVC); otherwise the variant is left out.
+#if defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+#include <immintrin.h>
+#define CV_CPU_DISPATCH_MODE AVX512_SKX
+#define CV_SSE3 1
+#define CV_SSSE3 1
+#define CV_SSE4_1 1
+#define CV_SSE4_2 1
+#define CV_POPCNT 1
+#define CV_AVX 1
+#define CV_AVX2 1
+#define CV_FMA3 1
+#define CV_AVX_512F 1
+#define CV_AVX_512CD 1
+#define CV_AVX_512BW 1
+#define CV_AVX_512DQ 1
+#define CV_AVX_512VL 1
+#define CV_AVX512_SKX 1
+#define SIMD_KERNELS_NAMESPACE simd_avx512
+#define SIMD_KERNELS_NAME "AVX-512"
+#include "SimdKernels.simd.hpp"
+
+const SimdKernels* simdKernelsAVX512()
+{
+    return &simd_avx512::kernels;
+}
+#else
+#include "SimdKernels.h"
+
+const SimdKernels* simdKernelsAVX512()
+{
+    return nullptr;
+}
+#endif
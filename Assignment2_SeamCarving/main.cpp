@@ -9,6 +9,43 @@
 #include <iostream>
 
 #ifdef SOLUTION
+/**
+ * @brief Matches a "--name=value" command-line option.
+ *
+ * @param arg   Command-line argument to inspect.
+ * @param name  Option prefix including the '=' (e.g. "--energy=").
+ * @param value Receives the text after the prefix when it matches.
+ * @return True if arg starts with name.
+ */
+static bool readOption(const std::string& arg, const std::string& name, std::string& value)
+{
+    if (arg.compare(0, name.size(), name) != 0)
+        return false;
+    value = arg.substr(name.size());
+    return true;
+}
+
+/**
+ * @brief Loads a binary mask image and writes its label into a MaskLabel layer.
+ * Every non-zero pixel of the mask image receives the label.
+ *
+ * @param path   Path of the mask image (any non-zero pixel is set).
+ * @param labels MaskLabel layer of the input image size.
+ * @param label  Label to write.
+ * @return False if the mask could not be loaded or does not match the image size.
+ */
+static bool applyMask(const std::string& path, cv::Mat& labels, MaskLabel label)
+{
+    cv::Mat mask = cv::imread(path, cv::IMREAD_GRAYSCALE);
+    if (mask.empty() || mask.size() != labels.size())
+    {
+        std::cerr << "Error: could not load mask '" << path << "' matching the image size." << std::endl;
+        return false;
+    }
+    labels.setTo(cv::Scalar(static_cast<int>(label)), mask);
+    return true;
+}
+
 int main(int argc, char** argv)
 {
     cv::utils::logging::setLogLevel(cv::utils::logging::LOG_LEVEL_WARNING);
@@ -17,10 +54,223 @@ int main(int argc, char** argv)
     int targetWidth;
     int targetHeight;
 
+    //Split "--option=value" flags from the positional arguments
+    std::vector<std::string> args;
+    EnergyEngine energyEngine = EnergyEngine::OpenCV;
+    bool integerEnergy = false;
+    std::string energyFunction = "sobel";
+    int varianceWindow = 5;
+    float saliencyWeight = 0.f;
+    SeamSearch seamSearch = SeamSearch::DP;
+    bool lowMemoryDP = false;
+    int seamsPerPass = 1;
+    int dpBand = 0;
+    int dpBlockHeight = 0;
+    int dpRowsPerStep = 0;
+    bool transposeHorizontal = false;
+    bool lazyGreedyEnergy = true;
+    int greedyBeam = 1;
+    bool multiStartGreedy = false;
+    std::string protectPath;
+    std::string removePath;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        std::string value;
+        if (readOption(arg, "--energy=", value))
+        {
+            if (value == "opencv")
+                energyEngine = EnergyEngine::OpenCV;
+            else if (value == "fused")
+                energyEngine = EnergyEngine::Fused;
+            else if (value == "parallel")
+                energyEngine = EnergyEngine::Parallel;
+            else
+            {
+                std::cerr << "Error: unknown energy engine '" << value << "' (expected opencv, fused or parallel)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--energy-fn=", value))
+        {
+            if (value != "sobel" && value != "scharr" && value != "l1" && value != "dual" && value != "colour" && value != "variance")
+            {
+                std::cerr << "Error: unknown energy function '" << value << "' (expected sobel, scharr, l1, dual, colour or variance)." << std::endl;
+                return -1;
+            }
+            energyFunction = value;
+        }
+        else if (readOption(arg, "--window=", value))
+        {
+            varianceWindow = std::stoi(value);
+            if (varianceWindow < 3 || varianceWindow % 2 == 0)
+            {
+                std::cerr << "Error: window size must be an odd number >= 3." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--saliency=", value))
+        {
+            saliencyWeight = std::stof(value);
+            if (saliencyWeight < 0.f)
+            {
+                std::cerr << "Error: saliency weight must not be negative." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--energy-type=", value))
+        {
+            if (value == "float")
+                integerEnergy = false;
+            else if (value == "u16")
+                integerEnergy = true;
+            else
+            {
+                std::cerr << "Error: unknown energy type '" << value << "' (expected float or u16)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--seam-energy=", value))
+        {
+            if (value == "backward")
+                seamSearch = SeamSearch::DP;
+            else if (value == "forward")
+                seamSearch = SeamSearch::ForwardDP;
+            else
+            {
+                std::cerr << "Error: unknown seam energy '" << value << "' (expected backward or forward)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--strategy=", value))
+        {
+            if (value == "dp")
+                seamSearch = SeamSearch::DP;
+            else if (value == "forward")
+                seamSearch = SeamSearch::ForwardDP;
+            else if (value == "greedy")
+                seamSearch = SeamSearch::Greedy;
+            else
+            {
+                std::cerr << "Error: unknown seam strategy '" << value << "' (expected dp, forward or greedy)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--dp-memory=", value))
+        {
+            if (value == "full")
+                lowMemoryDP = false;
+            else if (value == "low")
+                lowMemoryDP = true;
+            else
+            {
+                std::cerr << "Error: unknown DP memory mode '" << value << "' (expected full or low)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--dp-band=", value))
+        {
+            dpBand = std::stoi(value);
+            if (dpBand < 0)
+            {
+                std::cerr << "Error: DP band half-width must not be negative." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--dp-parallel=", value))
+        {
+            dpBlockHeight = std::stoi(value);
+            if (dpBlockHeight < 0)
+            {
+                std::cerr << "Error: DP block height must not be negative." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--dp-tiled=", value))
+        {
+            dpRowsPerStep = std::stoi(value);
+            if (dpRowsPerStep < 0)
+            {
+                std::cerr << "Error: DP rows per step must not be negative." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--horizontal=", value))
+        {
+            if (value == "direct")
+                transposeHorizontal = false;
+            else if (value == "transposed")
+                transposeHorizontal = true;
+            else
+            {
+                std::cerr << "Error: unknown horizontal mode '" << value << "' (expected direct or transposed)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--greedy-energy=", value))
+        {
+            if (value == "lazy")
+                lazyGreedyEnergy = true;
+            else if (value == "map")
+                lazyGreedyEnergy = false;
+            else
+            {
+                std::cerr << "Error: unknown greedy energy mode '" << value << "' (expected lazy or map)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--greedy-beam=", value))
+        {
+            greedyBeam = std::stoi(value);
+            if (greedyBeam < 1)
+            {
+                std::cerr << "Error: greedy beam width must be at least 1." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--greedy-starts=", value))
+        {
+            if (value == "one")
+                multiStartGreedy = false;
+            else if (value == "all")
+                multiStartGreedy = true;
+            else
+            {
+                std::cerr << "Error: unknown greedy start mode '" << value << "' (expected one or all)." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--seams-per-pass=", value))
+        {
+            seamsPerPass = std::stoi(value);
+            if (seamsPerPass < 1)
+            {
+                std::cerr << "Error: seams per pass must be at least 1." << std::endl;
+                return -1;
+            }
+        }
+        else if (readOption(arg, "--protect=", value))
+        {
+            protectPath = value;
+        }
+        else if (readOption(arg, "--remove=", value))
+        {
+            removePath = value;
+        }
+        else if (readOption(arg, "--threads=", value))
+        {
+            cv::setNumThreads(std::stoi(value));
+        }
+        else
+        {
+            args.push_back(arg);
+        }
+    }
+
     //For input image and resolutions
-    if (argc >= 2)
+    if (args.size() >= 1)
     {
-        path = argv[1];
+        path = args[0];
         std::cout << "Using input image from argument: " << path << std::endl;
     }
     else
@@ -38,10 +288,10 @@ int main(int argc, char** argv)
 
     std::cout << "Original size: " << image.size() << std::endl;
 
-    if (argc >= 4)
+    if (args.size() >= 3)
     {
-        targetWidth = std::stoi(argv[2]);
-        targetHeight = std::stoi(argv[3]);
+        targetWidth = std::stoi(args[1]);
+        targetHeight = std::stoi(args[2]);
         std::cout << "Target size from arguments: "
             << targetWidth << " x " << targetHeight << std::endl;
     }
@@ -61,7 +311,47 @@ int main(int argc, char** argv)
     }
 
     SeamCarver carver(image);
-    carver.resize(targetWidth, targetHeight);
+    carver.setEnergyEngine(energyEngine);
+    carver.setIntegerEnergy(integerEnergy);
+    if (energyFunction == "scharr")
+        carver.setEnergyFunction<ScharrEnergy>();
+    else if (energyFunction == "l1")
+        carver.setEnergyFunction<GradientL1Energy>();
+    else if (energyFunction == "dual")
+        carver.setEnergyFunction<DualGradientEnergy>();
+    else if (energyFunction == "colour")
+        carver.setEnergyFunction<ColourGradientEnergy>();
+    else if (energyFunction == "variance")
+        carver.setVarianceEnergy(varianceWindow / 2);
+    carver.setSaliencyWeight(saliencyWeight);
+    carver.setLowMemoryDP(lowMemoryDP);
+    carver.setBandedDP(dpBand);
+    carver.setParallelDP(dpBlockHeight);
+    carver.setTiledDP(dpRowsPerStep);
+    carver.setTransposedHorizontal(transposeHorizontal);
+    carver.setSeamsPerPass(seamsPerPass);
+    carver.setLazyGreedyEnergy(lazyGreedyEnergy);
+    carver.setGreedyBeam(greedyBeam);
+    carver.setMultiStartGreedy(multiStartGreedy);
+
+    //Protect/remove masks; removal wins where both are set
+    if (!protectPath.empty() || !removePath.empty())
+    {
+        cv::Mat labels(image.size(), CV_8UC1, cv::Scalar(static_cast<int>(MaskLabel::None)));
+        if (!protectPath.empty() && !applyMask(protectPath, labels, MaskLabel::Protect))
+            return -1;
+        if (!removePath.empty() && !applyMask(removePath, labels, MaskLabel::Remove))
+            return -1;
+        carver.setMask(labels);
+    }
+
+    //The seam strategy is a policy type, dispatched once for the whole job
+    if (seamSearch == SeamSearch::Greedy)
+        carver.resize<GreedySeams>(targetWidth, targetHeight);
+    else if (seamSearch == SeamSearch::ForwardDP)
+        carver.resize<ForwardDPSeams>(targetWidth, targetHeight);
+    else
+        carver.resize<DPSeams>(targetWidth, targetHeight);
 
     // Save result
     cv::Mat result = carver.getImage();